@@ -0,0 +1,56 @@
+#include "AllocationCounter.h"
+#include "Metrics.h"
+#include <new>
+#include <cstdlib>
+
+// Constant-initialized, so it is usable by allocations made during static
+// initialization
+static Counter g_allocations;
+
+uint64_t getGlobalAllocations() {
+    return g_allocations.value();
+}
+
+static void* countedAllocate(std::size_t size) {
+    g_allocations.inc();
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+static void* countedAllocate(std::size_t size, std::align_val_t alignment) {
+    g_allocations.inc();
+    void* p = nullptr;
+    size_t align = static_cast<size_t>(alignment);
+    if (align < sizeof(void*)) align = sizeof(void*);
+    if (posix_memalign(&p, align, size ? size : 1) != 0) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+// The array and nothrow forms forward to these in the standard library
+void* operator new(std::size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return countedAllocate(size, alignment);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <cstdint>
+
+// Process-wide count of global operator new calls.
+//
+// Linking AllocationCounter.cpp replaces the global operator new/delete
+// with malloc-backed versions that count every allocation, so the hot
+// path can be checked for allocations per message (see the STATS line and
+// process_allocations_total). Counting uses the sharded metrics Counter,
+// so it adds a few nanoseconds per allocation and no contention.
+uint64_t getGlobalAllocations();
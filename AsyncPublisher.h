@@ -0,0 +1,90 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <cstddef>
+
+// Hands records from one producer thread to a dedicated publishing thread.
+//
+// Slots are preallocated and written by assignment, so a record type that
+// owns buffers (strings, vectors) reuses them. The optional prepare step
+// sizes those buffers up front, so pushing never allocates. The producer
+// never blocks or makes a syscall: when the queue is full the record is
+// dropped and counted. The publishing thread polls and calls the handler for
+// each record in push order; formatting and I/O belong there, off the
+// producer's hot path.
+template <typename T>
+class AsyncPublisher {
+public:
+    using Handler = std::function<void(const T&)>;
+    using Prepare = std::function<void(T&)>;
+
+    AsyncPublisher(size_t capacity, Handler handler, Prepare prepare = nullptr)
+        : slots_(capacity), handler_(handler), head_(0), tail_(0), dropped_(0), running_(false) {
+        if (prepare) {
+            for (auto& slot : slots_) prepare(slot);
+        }
+    }
+
+    ~AsyncPublisher() {
+        stop();
+    }
+
+    void start() {
+        if (running_) return;
+        running_ = true;
+        thread_ = std::thread(&AsyncPublisher::publishThread, this);
+    }
+
+    // Publishes whatever is still queued before returning
+    void stop() {
+        if (!running_) return;
+        running_ = false;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    // Producer side; single thread only. False if the record was dropped.
+    bool push(const T& record) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == slots_.size()) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        slots_[tail % slots_.size()] = record;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t getDropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr auto POLL_INTERVAL = std::chrono::milliseconds(1);
+
+    std::vector<T> slots_;
+    Handler handler_;
+    alignas(64) std::atomic<size_t> head_; // Next slot to publish
+    alignas(64) std::atomic<size_t> tail_; // Next slot to fill
+    std::atomic<size_t> dropped_;
+    std::atomic<bool> running_;
+    std::thread thread_;
+
+    void publishThread() {
+        while (true) {
+            bool stopping = !running_;
+            size_t head = head_.load(std::memory_order_relaxed);
+            size_t tail = tail_.load(std::memory_order_acquire);
+            for (; head != tail; ++head) {
+                handler_(slots_[head % slots_.size()]);
+                head_.store(head + 1, std::memory_order_release);
+            }
+            if (stopping) break;
+            std::this_thread::sleep_for(POLL_INTERVAL);
+        }
+    }
+};
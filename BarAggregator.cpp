@@ -0,0 +1,81 @@
+#include "BarAggregator.h"
+#include "Timestamp.h"
+#include <algorithm>
+
+BarAggregator::BarAggregator(const std::vector<int64_t>& intervalSeconds) 
+    : barsCompleted_(0) {
+    for (int64_t seconds : intervalSeconds) {
+        intervalNanos_.push_back(seconds * NANOS_PER_SECOND);
+    }
+}
+
+void BarAggregator::setBarCallback(BarCallback callback) {
+    callback_ = callback;
+}
+
+void BarAggregator::onTrade(const std::string& symbol, int64_t tickNanos, double price, int size) {
+    auto it = openBars_.find(symbol);
+    if (it == openBars_.end()) {
+        it = openBars_.emplace(symbol, std::vector<Bar>(intervalNanos_.size())).first;
+        for (size_t i = 0; i < intervalNanos_.size(); ++i) {
+            it->second[i].symbol = symbol;
+            it->second[i].intervalNanos = intervalNanos_[i];
+        }
+    }
+    
+    for (Bar& bar : it->second) {
+        int64_t bucket = tickNanos - (tickNanos % bar.intervalNanos + bar.intervalNanos) % bar.intervalNanos;
+        
+        if (bar.tradeCount > 0 && bucket > bar.startNanos) {
+            closeBar(bar);
+        }
+        
+        if (bar.tradeCount == 0) {
+            bar.startNanos = bucket;
+            bar.open = price;
+            bar.high = price;
+            bar.low = price;
+        } else {
+            bar.high = std::max(bar.high, price);
+            bar.low = std::min(bar.low, price);
+        }
+        
+        // Late ticks count towards the open bar but do not move its close
+        if (bucket >= bar.startNanos) {
+            bar.close = price;
+        }
+        bar.volume += size;
+        bar.notional += price * size;
+        bar.tradeCount++;
+    }
+}
+
+void BarAggregator::flush() {
+    for (auto& [symbol, bars] : openBars_) {
+        for (Bar& bar : bars) {
+            if (bar.tradeCount > 0) {
+                closeBar(bar);
+            }
+        }
+    }
+}
+
+const std::vector<int64_t>& BarAggregator::getIntervals() const {
+    return intervalNanos_;
+}
+
+size_t BarAggregator::getBarsCompleted() const {
+    return barsCompleted_;
+}
+
+void BarAggregator::closeBar(Bar& bar) {
+    barsCompleted_++;
+    if (callback_) {
+        callback_(bar);
+    }
+    
+    // Reset in place; symbol and interval stay
+    bar.volume = 0;
+    bar.notional = 0.0;
+    bar.tradeCount = 0;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include "FeedHandler.h"
+
+// OHLCV bar for one symbol and interval, keyed by tick time
+struct Bar {
+    std::string symbol;
+    int64_t startNanos = 0;     // Bucket start, nanoseconds since epoch
+    int64_t intervalNanos = 0;
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double close = 0.0;
+    int64_t volume = 0;
+    double notional = 0.0;      // Sum of price * size, for VWAP
+    uint32_t tradeCount = 0;
+    
+    double vwap() const {
+        return volume > 0 ? notional / volume : close;
+    }
+};
+
+// Incremental time-bucketed bar builder.
+//
+// Each symbol keeps one open bar per interval; a tick updates every open bar
+// in O(1). A bar closes when a tick for the same symbol lands in a later
+// bucket (tick time, not wall clock), so intervals without trades produce no
+// bar. Ticks older than the open bar are folded into it rather than dropped.
+class BarAggregator {
+public:
+    using BarCallback = std::function<void(const Bar&)>;
+    
+    explicit BarAggregator(const std::vector<int64_t>& intervalSeconds = {1, 60, 300});
+    
+    // Called for each completed bar
+    void setBarCallback(BarCallback callback);
+    
+    void onTrade(const std::string& symbol, int64_t tickNanos, double price, int size);
+    
+    // Close every open bar (e.g. at shutdown)
+    void flush();
+    
+    const std::vector<int64_t>& getIntervals() const;
+    size_t getBarsCompleted() const;
+    
+private:
+    std::vector<int64_t> intervalNanos_;
+    std::unordered_map<std::string, std::vector<Bar>> openBars_;
+    BarCallback callback_;
+    size_t barsCompleted_;
+    
+    void closeBar(Bar& bar);
+};
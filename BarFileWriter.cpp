@@ -0,0 +1,110 @@
+#include "BarFileWriter.h"
+#include <iostream>
+#include <algorithm>
+
+BarFileWriter::BarFileWriter() {}
+
+BarFileWriter::~BarFileWriter() {
+    close();
+}
+
+bool BarFileWriter::open(const std::string& path) {
+    close();
+    
+    // Only write the header for a new file so runs can append
+    std::ifstream existing(path, std::ios::binary);
+    bool isNew = !existing.good() || existing.peek() == std::ifstream::traits_type::eof();
+    existing.close();
+    
+    out_.open(path, std::ios::binary | std::ios::app);
+    if (!out_) {
+        std::cerr << "Failed to open bar file: " << path << std::endl;
+        return false;
+    }
+    
+    if (isNew) {
+        out_.write("OHLCVBAR", 8);
+        out_.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    }
+    return true;
+}
+
+void BarFileWriter::append(const Bar& bar) {
+    if (!out_.is_open()) return;
+    
+    symbolIndex_.push_back(symbolIndex(bar.symbol));
+    start_.push_back(bar.startNanos);
+    interval_.push_back(bar.intervalNanos);
+    open_.push_back(bar.open);
+    high_.push_back(bar.high);
+    low_.push_back(bar.low);
+    close_.push_back(bar.close);
+    volume_.push_back(bar.volume);
+    vwap_.push_back(bar.vwap());
+    tradeCount_.push_back(bar.tradeCount);
+    
+    if (start_.size() >= BLOCK_ROWS) {
+        flush();
+    }
+}
+
+void BarFileWriter::flush() {
+    if (!out_.is_open() || start_.empty()) return;
+    
+    uint32_t rows = static_cast<uint32_t>(start_.size());
+    uint16_t symbolCount = static_cast<uint16_t>(symbols_.size());
+    out_.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+    out_.write(reinterpret_cast<const char*>(&symbolCount), sizeof(symbolCount));
+    for (const auto& symbol : symbols_) {
+        uint8_t length = static_cast<uint8_t>(std::min<size_t>(symbol.size(), 255));
+        out_.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out_.write(symbol.data(), length);
+    }
+    
+    writeColumn(symbolIndex_);
+    writeColumn(start_);
+    writeColumn(interval_);
+    writeColumn(open_);
+    writeColumn(high_);
+    writeColumn(low_);
+    writeColumn(close_);
+    writeColumn(volume_);
+    writeColumn(vwap_);
+    writeColumn(tradeCount_);
+    out_.flush();
+    
+    clearBlock();
+}
+
+void BarFileWriter::close() {
+    if (!out_.is_open()) return;
+    flush();
+    out_.close();
+}
+
+bool BarFileWriter::isOpen() const {
+    return out_.is_open();
+}
+
+uint16_t BarFileWriter::symbolIndex(const std::string& symbol) {
+    auto it = std::find(symbols_.begin(), symbols_.end(), symbol);
+    if (it != symbols_.end()) {
+        return static_cast<uint16_t>(it - symbols_.begin());
+    }
+    symbols_.push_back(symbol);
+    return static_cast<uint16_t>(symbols_.size() - 1);
+}
+
+void BarFileWriter::clearBlock() {
+    symbols_.clear();
+    symbolIndex_.clear();
+    start_.clear();
+    interval_.clear();
+    open_.clear();
+    high_.clear();
+    low_.clear();
+    close_.clear();
+    volume_.clear();
+    vwap_.clear();
+    tradeCount_.clear();
+}
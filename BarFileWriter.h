@@ -0,0 +1,58 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include "BarAggregator.h"
+
+// Append-only columnar bar file.
+//
+// Layout (little-endian):
+//   header: "OHLCVBAR" magic, uint32 version
+//   blocks: uint32 rowCount, uint16 symbolCount,
+//           symbolCount x (uint8 length, bytes),
+//           then one array per column, rowCount entries each:
+//           uint16 symbolIndex, int64 startNanos, int64 intervalNanos,
+//           double open, high, low, close, int64 volume, double vwap,
+//           uint32 tradeCount
+//
+// Bars are buffered per column and written a block at a time; see
+// tools/read_bars.py for a reader.
+class BarFileWriter {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t BLOCK_ROWS = 1024;
+    
+    BarFileWriter();
+    ~BarFileWriter();
+    
+    bool open(const std::string& path);
+    void append(const Bar& bar);
+    void flush();
+    void close();
+    bool isOpen() const;
+    
+private:
+    std::ofstream out_;
+    
+    // Column buffers for the current block
+    std::vector<std::string> symbols_;
+    std::vector<uint16_t> symbolIndex_;
+    std::vector<int64_t> start_;
+    std::vector<int64_t> interval_;
+    std::vector<double> open_;
+    std::vector<double> high_;
+    std::vector<double> low_;
+    std::vector<double> close_;
+    std::vector<int64_t> volume_;
+    std::vector<double> vwap_;
+    std::vector<uint32_t> tradeCount_;
+    
+    uint16_t symbolIndex(const std::string& symbol);
+    void clearBlock();
+    
+    template <typename T>
+    void writeColumn(const std::vector<T>& column) {
+        out_.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+    }
+};
@@ -5,12 +5,54 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <cstring>
-#include <sstream>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
 #include <chrono>
 
+// Single-character book fields: side B/S, action A(dd)/M(odify)/D(elete)/T(rade)
+static bool parseSide(char c, Side& side) {
+    switch (c) {
+        case 'B': side = Side::BID; return true;
+        case 'S': side = Side::ASK; return true;
+        case 'N': side = Side::NONE; return true;
+        default: return false;
+    }
+}
+
+static bool parseAction(char c, Action& action) {
+    switch (c) {
+        case 'A': action = Action::ADD; return true;
+        case 'M': action = Action::MODIFY; return true;
+        case 'D': action = Action::DELETE; return true;
+        case 'T': action = Action::TRADE; return true;
+        default: return false;
+    }
+}
+
+const char* subscriberTypeName(SubscriberType type) {
+    switch (type) {
+        case SubscriberType::TRADING_ALGORITHM: return "trading";
+        case SubscriberType::RISK_MANAGEMENT: return "risk";
+        case SubscriberType::ANALYTICS: return "analytics";
+        case SubscriberType::ORDER_BOOK: return "order_book";
+        case SubscriberType::BARS: return "bars";
+        case SubscriberType::TICK_STORE: return "tick_store";
+        case SubscriberType::SHARED_MEMORY: return "shared_memory";
+    }
+    return "unknown";
+}
+
 FeedHandler::FeedHandler(const std::string& host, int port)
     : host_(host), port_(port), sockfd_(-1), running_(false), 
-      messagesProcessed_(0), totalProcessingTimeMicros_(0) {}
+      messagesProcessed_(MetricsRegistry::instance().counter(
+          "feedhandler_messages_total", "Messages parsed and published")),
+      parseErrors_(MetricsRegistry::instance().counter(
+          "feedhandler_parse_errors_total", "Messages rejected by the parser")),
+      bytesReceived_(MetricsRegistry::instance().counter(
+          "feedhandler_bytes_received_total", "Bytes read from the feed socket")),
+      processingTime_(MetricsRegistry::instance().histogram(
+          "feedhandler_processing_seconds", "Parse and publish time per message")) {}
 
 FeedHandler::~FeedHandler() {
     stop();
@@ -20,6 +62,16 @@ void FeedHandler::setMessageBroker(std::shared_ptr<ThreadSafeMessageBroker> brok
     messageBroker_ = broker;
 }
 
+void FeedHandler::addOrderedSubscriber(SubscriberType type, OrderedCallback callback) {
+    std::string labels = std::string("subscriber=\"") + subscriberTypeName(type) + "\"";
+    orderedSubscribers_.push_back(OrderedSubscription{
+        callback,
+        &MetricsRegistry::instance().histogram(
+            "subscriber_callback_seconds", "Time spent in each subscriber callback", labels),
+        &MetricsRegistry::instance().counter(
+            "subscriber_errors_total", "Exceptions thrown by subscriber callbacks", labels)});
+}
+
 void FeedHandler::start() {
     if (running_) return;
     
@@ -65,10 +117,11 @@ void FeedHandler::stop() {
 
 void FeedHandler::networkThreadFunction() {
     char buffer[4096]; // Larger buffer for high throughput
-    std::string messageBuffer;
+    messageBuffer_.clear();
+    messageBuffer_.reserve(2 * sizeof(buffer));
     
     while (running_) {
-        ssize_t n = read(sockfd_, buffer, sizeof(buffer) - 1);
+        ssize_t n = read(sockfd_, buffer, sizeof(buffer));
         if (n <= 0) {
             if (running_) {
                 std::cerr << "Connection lost or error reading from socket\n";
@@ -76,74 +129,115 @@ void FeedHandler::networkThreadFunction() {
             break;
         }
         
-        buffer[n] = '\0';
-        messageBuffer += std::string(buffer);
+        bytesReceived_.inc(n);
+        messageBuffer_.append(buffer, n);
         
-        // Process complete messages (assuming newline-delimited)
-        size_t pos = 0;
-        while ((pos = messageBuffer.find('\n')) != std::string::npos) {
-            std::string message = messageBuffer.substr(0, pos);
-            messageBuffer.erase(0, pos + 1);
-            
-            if (!message.empty()) {
-                processMessage(message);
+        // Process complete messages (assuming newline-delimited), then drop
+        // the consumed prefix in one go instead of erasing per message
+        size_t start = 0;
+        size_t pos;
+        while ((pos = messageBuffer_.find('\n', start)) != std::string::npos) {
+            if (pos > start) {
+                line_.assign(messageBuffer_, start, pos - start);
+                processMessage(line_);
             }
+            start = pos + 1;
         }
+        messageBuffer_.erase(0, start);
     }
 }
 
 void FeedHandler::processMessage(const std::string& msg) {
-    auto start = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::steady_clock::now();
     
-    MarketData data;
-    if (parseMarketData(msg, data)) {
+    if (parseMarketData(msg, parsed_)) {
+        for (const auto& subscription : orderedSubscribers_) {
+            ScopedTimer timer(*subscription.callbackTime);
+            try {
+                subscription.callback(parsed_);
+            } catch (const std::exception& e) {
+                subscription.errors->inc();
+                std::cerr << "Error in ordered subscriber: " << e.what() << std::endl;
+            }
+        }
+        
         // Publish to message broker if available
         if (messageBroker_) {
-            messageBroker_->publishMessage(data);
+            messageBroker_->publishMessage(parsed_);
         }
         
-        messagesProcessed_++;
+        messagesProcessed_.inc();
         
         // Calculate processing time
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        totalProcessingTimeMicros_ += duration.count();
+        auto end = std::chrono::steady_clock::now();
+        processingTime_.observe(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    } else {
+        parseErrors_.inc();
     }
 }
 
 bool FeedHandler::parseMarketData(const std::string& msg, MarketData& data) {
-    try {
-        std::istringstream ss(msg);
-        std::string symbol, price_str, size_str, timestamp_str;
+    // Parse CSV format: symbol,price,size,timestamp[,side,action]
+    // Fields are split in place so the target's string buffers get reused.
+    // Messages without side/action are trades; a lone fifth field (the
+    // generator's sequence number) is ignored.
+    size_t priceStart = msg.find(',');
+    size_t sizeStart = priceStart == std::string::npos ? priceStart : msg.find(',', priceStart + 1);
+    size_t timestampStart = sizeStart == std::string::npos ? sizeStart : msg.find(',', sizeStart + 1);
+    
+    if (timestampStart == std::string::npos) {
+        std::cerr << "Malformed message: " << msg << std::endl;
+        return false;
+    }
+    
+    const char* base = msg.c_str();
+    char* end = nullptr;
+    
+    errno = 0;
+    double price = std::strtod(base + priceStart + 1, &end);
+    if (end == base + priceStart + 1 || end != base + sizeStart || errno == ERANGE) {
+        std::cerr << "Parse error: invalid price in message: " << msg << std::endl;
+        return false;
+    }
+    
+    long size = std::strtol(base + sizeStart + 1, &end, 10);
+    if (end == base + sizeStart + 1 || end != base + timestampStart || errno == ERANGE ||
+        size < INT_MIN || size > INT_MAX) {
+        std::cerr << "Parse error: invalid size in message: " << msg << std::endl;
+        return false;
+    }
+    
+    size_t sideStart = msg.find(',', timestampStart + 1);
+    size_t actionStart = sideStart == std::string::npos ? sideStart : msg.find(',', sideStart + 1);
+    
+    Side side = Side::NONE;
+    Action action = Action::TRADE;
+    if (actionStart != std::string::npos) {
+        size_t actionEnd = msg.find(',', actionStart + 1);
+        if (actionEnd == std::string::npos) actionEnd = msg.size();
         
-        // Parse CSV format: symbol,price,size,timestamp
-        if (std::getline(ss, symbol, ',') &&
-            std::getline(ss, price_str, ',') &&
-            std::getline(ss, size_str, ',') &&
-            std::getline(ss, timestamp_str)) {
-            
-            data.symbol = symbol;
-            data.price = std::stod(price_str);
-            data.size = std::stoi(size_str);
-            data.timestamp = timestamp_str;
-            
-            return true;
-        } else {
-            std::cerr << "Malformed message: " << msg << std::endl;
+        if (actionStart - sideStart != 2 || actionEnd - actionStart != 2 ||
+            !parseSide(msg[sideStart + 1], side) || !parseAction(msg[actionStart + 1], action)) {
+            std::cerr << "Parse error: invalid side/action in message: " << msg << std::endl;
             return false;
         }
-    } catch (const std::exception& e) {
-        std::cerr << "Parse error: " << e.what() << " in message: " << msg << std::endl;
-        return false;
     }
+    
+    data.symbol.assign(msg, 0, priceStart);
+    data.price = price;
+    data.size = static_cast<int>(size);
+    data.timestamp.assign(msg, timestampStart + 1,
+                          sideStart == std::string::npos ? std::string::npos : sideStart - timestampStart - 1);
+    data.side = side;
+    data.action = action;
+    
+    return true;
 }
 
 size_t FeedHandler::getMessagesProcessed() const {
-    return messagesProcessed_;
+    return messagesProcessed_.value();
 }
 
 double FeedHandler::getAverageProcessingTime() const {
-    size_t count = messagesProcessed_;
-    if (count == 0) return 0.0;
-    return static_cast<double>(totalProcessingTimeMicros_) / count / 1000.0; // Convert to milliseconds
+    return processingTime_.snapshot().mean() / 1e6; // Convert to milliseconds
 }
\ No newline at end of file
@@ -3,19 +3,55 @@
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <vector>
+#include <functional>
+#include "Metrics.h"
 
 // Forward declaration
 class ThreadSafeMessageBroker;
 
+// Book side of an event; NONE for plain last-trade ticks
+enum class Side : char {
+    NONE,
+    BID,
+    ASK
+};
+
+// Event type; legacy SYMBOL,PRICE,SIZE ticks are TRADE
+enum class Action : char {
+    TRADE,
+    ADD,
+    MODIFY,
+    DELETE
+};
+
 struct MarketData {
     std::string symbol;
     double price;
     int size;
     std::string timestamp;
+    Side side = Side::NONE;
+    Action action = Action::TRADE;
 };
 
+// Subscriber types for different components
+enum class SubscriberType {
+    TRADING_ALGORITHM,
+    RISK_MANAGEMENT,
+    ANALYTICS,
+    ORDER_BOOK,
+    BARS,
+    TICK_STORE,
+    SHARED_MEMORY
+};
+
+// Label used for per-subscriber metrics
+const char* subscriberTypeName(SubscriberType type);
+
 class FeedHandler {
 public:
+    using OrderedCallback = std::function<void(const MarketData&)>;
+    
     FeedHandler(const std::string& host, int port);
     ~FeedHandler();
     
@@ -26,9 +62,18 @@ public:
     // Set the message broker for publishing
     void setMessageBroker(std::shared_ptr<ThreadSafeMessageBroker> broker);
     
+    // Consumers that need strict feed order (e.g. book reconstruction) run
+    // on the network thread, in registration order, before the message is
+    // queued to the broker. Register before start(). Each type gets the
+    // same per-subscriber metrics as a broker subscription.
+    void addOrderedSubscriber(SubscriberType type, OrderedCallback callback);
+    
     // Statistics
     size_t getMessagesProcessed() const;
     double getAverageProcessingTime() const;
+    
+    // Parse one CSV line into `data`, reusing its string buffers
+    static bool parseMarketData(const std::string& msg, MarketData& data);
 
 private:
     std::string host_;
@@ -39,14 +84,25 @@ private:
     
     // Message broker for publishing
     std::shared_ptr<ThreadSafeMessageBroker> messageBroker_;
+    struct OrderedSubscription {
+        OrderedCallback callback;
+        Histogram* callbackTime;
+        Counter* errors;
+    };
+    std::vector<OrderedSubscription> orderedSubscribers_;
     
-    // Statistics
-    std::atomic<size_t> messagesProcessed_;
-    std::atomic<uint64_t> totalProcessingTimeMicros_;
+    // Statistics (registered in the metrics registry)
+    Counter& messagesProcessed_;
+    Counter& parseErrors_;
+    Counter& bytesReceived_;
+    Histogram& processingTime_;
+    
+    // Scratch buffers reused by the network thread so steady-state
+    // parsing does not allocate
+    std::string messageBuffer_;
+    std::string line_;
+    MarketData parsed_;
     
     // Network thread function
     void networkThreadFunction();
-    
-    // Parse message with error handling
-    bool parseMarketData(const std::string& msg, MarketData& data);
 };
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "Metrics.h"
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <stdexcept>
+
+MetricShardSlot assignMetricShard() {
+    static std::atomic<size_t> nextShard{0};
+    size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed);
+    if (shard < METRIC_SHARDS - 1) {
+        return MetricShardSlot{shard, true};
+    }
+    return MetricShardSlot{METRIC_SHARDS - 1, false};
+}
+
+uint64_t Counter::value() const {
+    uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+    Snapshot result;
+    for (const auto& shard : shards_) {
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            uint64_t n = shard.buckets[i].load(std::memory_order_relaxed);
+            result.buckets[i] += n;
+            result.count += n;
+        }
+        result.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+uint64_t Histogram::Snapshot::quantile(double q) const {
+    if (count == 0) return 0;
+
+    uint64_t target = static_cast<uint64_t>(q * count);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen > target) {
+            return 1ULL << i;
+        }
+    }
+    return 1ULL << (BUCKETS - 1);
+}
+
+MetricsRegistry& MetricsRegistry::instance() {
+    // Never destroyed: components holding metric references (global
+    // subscribers, the broker) may still update them during static teardown
+    static MetricsRegistry* registry = new MetricsRegistry;
+    return *registry;
+}
+
+MetricsRegistry::Series& MetricsRegistry::getSeries(const std::string& name, const std::string& help,
+                                                    const std::string& labels, Type type) {
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+        it = families_.emplace(name, Family{type, help, {}}).first;
+    } else if (it->second.type != type) {
+        throw std::invalid_argument("Metric " + name + " registered with a different type");
+    }
+    return it->second.series[labels];
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Series& series = getSeries(name, help, labels, Type::COUNTER);
+    if (!series.counter) series.counter = std::make_unique<Counter>();
+    return *series.counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Series& series = getSeries(name, help, labels, Type::GAUGE);
+    if (!series.gauge) series.gauge = std::make_unique<Gauge>();
+    return *series.gauge;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Series& series = getSeries(name, help, labels, Type::HISTOGRAM);
+    if (!series.histogram) series.histogram = std::make_unique<Histogram>();
+    return *series.histogram;
+}
+
+void MetricsRegistry::gaugeFunction(const std::string& name, const std::string& help,
+                                    const std::string& labels, GaugeFunction function) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    getSeries(name, help, labels, Type::GAUGE).function = function;
+}
+
+void MetricsRegistry::counterFunction(const std::string& name, const std::string& help,
+                                      const std::string& labels, GaugeFunction function) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    getSeries(name, help, labels, Type::COUNTER).function = function;
+}
+
+// Join a series' own labels with an extra one (used for histogram "le")
+static std::string labelSet(const std::string& labels, const std::string& extra = "") {
+    if (labels.empty() && extra.empty()) return "";
+    if (labels.empty()) return "{" + extra + "}";
+    if (extra.empty()) return "{" + labels + "}";
+    return "{" + labels + "," + extra + "}";
+}
+
+// Sample values: integral values as integers, anything else with enough
+// digits to round-trip, never the 6-digit default (1.23457e+06)
+static void writeValue(std::ostream& out, double value) {
+    if (std::isnan(value)) {
+        out << "NaN";
+    } else if (std::isinf(value)) {
+        out << (value > 0 ? "+Inf" : "-Inf");
+    } else if (std::floor(value) == value && std::fabs(value) < 9007199254740992.0) { // 2^53
+        out << static_cast<int64_t>(value);
+    } else {
+        // Shortest form that parses back to the same double
+        char buffer[32];
+        for (int precision = 15; precision <= 17; ++precision) {
+            std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+            if (std::strtod(buffer, nullptr) == value) break;
+        }
+        out << buffer;
+    }
+}
+
+std::string MetricsRegistry::renderPrometheus() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream out;
+
+    for (const auto& [name, family] : families_) {
+        const char* type = family.type == Type::COUNTER ? "counter"
+                         : family.type == Type::GAUGE ? "gauge" : "histogram";
+        out << "# HELP " << name << " " << family.help << "\n";
+        out << "# TYPE " << name << " " << type << "\n";
+
+        for (const auto& [labels, series] : family.series) {
+            if (series.function) {
+                out << name << labelSet(labels) << " ";
+                writeValue(out, series.function());
+                out << "\n";
+            } else if (series.counter) {
+                out << name << labelSet(labels) << " " << series.counter->value() << "\n";
+            } else if (series.gauge) {
+                out << name << labelSet(labels) << " " << series.gauge->value() << "\n";
+            } else if (series.histogram) {
+                // Exported in seconds, per Prometheus convention
+                Histogram::Snapshot snap = series.histogram->snapshot();
+                uint64_t cumulative = 0;
+                for (size_t i = 0; i + 1 < Histogram::BUCKETS; ++i) {
+                    cumulative += snap.buckets[i];
+                    std::ostringstream le;
+                    le << "le=\"";
+                    writeValue(le, static_cast<double>(1ULL << i) / 1e9);
+                    le << "\"";
+                    out << name << "_bucket" << labelSet(labels, le.str()) << " " << cumulative << "\n";
+                }
+                out << name << "_bucket" << labelSet(labels, "le=\"+Inf\"") << " " << snap.count << "\n";
+                out << name << "_sum" << labelSet(labels) << " ";
+                writeValue(out, snap.sum / 1e9);
+                out << "\n";
+                out << name << "_count" << labelSet(labels) << " " << snap.count << "\n";
+            }
+        }
+    }
+    return out.str();
+}
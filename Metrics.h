@@ -0,0 +1,167 @@
+#pragma once
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+// Lock-free metrics with per-thread shards.
+//
+// Counters and histograms are split into cache-line-padded shards. The
+// first METRIC_SHARDS - 1 threads that record each own a shard outright and
+// update it with a plain relaxed load/store (no locked instruction, a
+// couple of nanoseconds); any further threads share the last shard via
+// fetch_add. Shards are only summed on read.
+// Metrics are registered once by name + label set and live for the
+// lifetime of the process, so components keep plain references to them.
+
+constexpr size_t METRIC_SHARDS = 32;
+
+struct MetricShardSlot {
+    size_t index;
+    bool exclusive; // Only this thread writes the shard
+};
+
+// Shard of the calling thread, assigned on first use
+MetricShardSlot assignMetricShard();
+
+inline const MetricShardSlot& metricShard() {
+    static thread_local MetricShardSlot slot = assignMetricShard();
+    return slot;
+}
+
+inline void metricAdd(std::atomic<uint64_t>& value, uint64_t n, bool exclusive) {
+    if (exclusive) {
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    } else {
+        value.fetch_add(n, std::memory_order_relaxed);
+    }
+}
+
+class Counter {
+public:
+    void inc(uint64_t n = 1) {
+        const MetricShardSlot& slot = metricShard();
+        metricAdd(shards_[slot.index].value, n, slot.exclusive);
+    }
+
+    uint64_t value() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+    Shard shards_[METRIC_SHARDS];
+};
+
+// Point-in-time value (queue depth, sizes); a single atomic
+class Gauge {
+public:
+    void set(int64_t v) { value_.store(v, std::memory_order_relaxed); }
+    void add(int64_t n) { value_.fetch_add(n, std::memory_order_relaxed); }
+    int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> value_{0};
+};
+
+// Latency histogram in nanoseconds with power-of-two buckets:
+// bucket i counts observations <= 2^i ns (the last bucket is unbounded)
+class Histogram {
+public:
+    static constexpr size_t BUCKETS = 40;
+
+    void observe(uint64_t nanos) {
+        size_t bucket = nanos == 0 ? 0 : 64 - __builtin_clzll(nanos);
+        if (nanos != 0 && (nanos & (nanos - 1)) == 0) bucket--; // Exact powers of two
+        if (bucket >= BUCKETS) bucket = BUCKETS - 1;
+
+        const MetricShardSlot& slot = metricShard();
+        Shard& shard = shards_[slot.index];
+        metricAdd(shard.buckets[bucket], 1, slot.exclusive);
+        metricAdd(shard.sum, nanos, slot.exclusive);
+    }
+
+    struct Snapshot {
+        uint64_t buckets[BUCKETS] = {};
+        uint64_t count = 0;
+        uint64_t sum = 0; // Nanoseconds
+
+        double mean() const { return count ? static_cast<double>(sum) / count : 0.0; }
+        uint64_t quantile(double q) const; // Bucket upper bound, nanoseconds
+    };
+
+    Snapshot snapshot() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> buckets[BUCKETS] = {};
+        std::atomic<uint64_t> sum{0};
+    };
+    Shard shards_[METRIC_SHARDS];
+};
+
+// Times a scope into a histogram
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram& histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        histogram_.observe(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_).count());
+    }
+
+private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+class MetricsRegistry {
+public:
+    using GaugeFunction = std::function<double()>;
+
+    static MetricsRegistry& instance();
+
+    // Get-or-create; `labels` is the Prometheus label body, e.g.
+    // subscriber="risk". Throws std::invalid_argument if the name is
+    // already registered with a different type.
+    Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+    Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+    Histogram& histogram(const std::string& name, const std::string& help, const std::string& labels = "");
+
+    // Series computed on read, for values a component already tracks
+    void gaugeFunction(const std::string& name, const std::string& help,
+                       const std::string& labels, GaugeFunction function);
+    void counterFunction(const std::string& name, const std::string& help,
+                         const std::string& labels, GaugeFunction function);
+
+    // Prometheus text exposition format (0.0.4)
+    std::string renderPrometheus() const;
+
+private:
+    enum class Type { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Series {
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+        GaugeFunction function;
+    };
+
+    struct Family {
+        Type type;
+        std::string help;
+        std::map<std::string, Series> series; // Keyed by labels
+    };
+
+    std::map<std::string, Family> families_;
+    mutable std::mutex mutex_;
+
+    MetricsRegistry() = default;
+    Series& getSeries(const std::string& name, const std::string& help,
+                      const std::string& labels, Type type);
+};
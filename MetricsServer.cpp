@@ -0,0 +1,105 @@
+#include "MetricsServer.h"
+#include "Metrics.h"
+#include <iostream>
+#include <cstring>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+
+MetricsServer::MetricsServer(const std::string& host, int port)
+    : host_(host), port_(port), listenFd_(-1), running_(false) {}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool MetricsServer::start() {
+    if (running_) return true;
+    
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        std::cerr << "Metrics socket creation failed\n";
+        return false;
+    }
+    
+    int reuse = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port_);
+    inet_pton(AF_INET, host_.c_str(), &addr.sin_addr);
+    
+    if (bind(listenFd_, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(listenFd_, 8) < 0) {
+        std::cerr << "Metrics endpoint failed to listen on " << host_ << ":" << port_ 
+                  << ": " << std::strerror(errno) << std::endl;
+        close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+    
+    running_ = true;
+    serverThread_ = std::thread(&MetricsServer::serverThreadFunction, this);
+    std::cout << "Metrics available at http://" << host_ << ":" << port_ << "/metrics" << std::endl;
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (!running_) return;
+    
+    running_ = false;
+    if (serverThread_.joinable()) {
+        serverThread_.join();
+    }
+    
+    close(listenFd_);
+    listenFd_ = -1;
+}
+
+void MetricsServer::serverThreadFunction() {
+    while (running_) {
+        // Poll so stop() is noticed without closing the socket under accept()
+        pollfd pfd{listenFd_, POLLIN, 0};
+        if (poll(&pfd, 1, 200) <= 0) continue;
+        
+        int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) continue;
+        
+        handleConnection(fd);
+        close(fd);
+    }
+}
+
+void MetricsServer::handleConnection(int fd) {
+    // Don't let a stalled client hold up the endpoint
+    timeval timeout{1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    
+    char buffer[2048];
+    ssize_t n = read(fd, buffer, sizeof(buffer) - 1);
+    if (n <= 0) return;
+    buffer[n] = '\0';
+    
+    std::string body;
+    std::string status;
+    if (std::strncmp(buffer, "GET /metrics", 12) == 0) {
+        status = "200 OK";
+        body = MetricsRegistry::instance().renderPrometheus();
+    } else {
+        status = "404 Not Found";
+        body = "Try /metrics\n";
+    }
+    
+    std::string response = "HTTP/1.1 " + status + "\r\n"
+        "Content-Type: text/plain; version=0.0.4\r\n"
+        "Content-Length: " + std::to_string(body.size()) + "\r\n"
+        "Connection: close\r\n\r\n" + body;
+    
+    size_t sent = 0;
+    while (sent < response.size()) {
+        ssize_t w = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (w <= 0) break;
+        sent += w;
+    }
+}
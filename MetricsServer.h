@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+#include <thread>
+#include <atomic>
+
+// Minimal HTTP endpoint serving the metrics registry in Prometheus text
+// format on GET /metrics. Binds to localhost only; one request per
+// connection, handled on a single background thread.
+class MetricsServer {
+public:
+    MetricsServer(const std::string& host, int port);
+    ~MetricsServer();
+    
+    bool start();
+    void stop();
+    
+private:
+    std::string host_;
+    int port_;
+    int listenFd_;
+    std::atomic<bool> running_;
+    std::thread serverThread_;
+    
+    void serverThreadFunction();
+    void handleConnection(int fd);
+};
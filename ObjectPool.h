@@ -0,0 +1,120 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <algorithm>
+
+// Fixed-size record pool with per-thread free lists.
+//
+// Records are carved out of slabs that are never handed back to the global
+// allocator. A released record keeps its internal buffers (e.g. string
+// capacity), so once the pool is warm, acquire/release and refilling the
+// record's fields do not allocate. Each thread caches up to 2 * BATCH_SIZE
+// free records and only touches the shared list (under a mutex) to move a
+// whole batch, which keeps producer/consumer hand-off cheap.
+template <typename T>
+class ObjectPool {
+public:
+    static constexpr size_t SLAB_SIZE = 256;
+    static constexpr size_t BATCH_SIZE = 64;
+
+    // One pool per record type, shared by every thread. Never destroyed:
+    // thread caches and owners of pooled records (e.g. a global broker) may
+    // still hand records back while static objects are being torn down.
+    static ObjectPool& instance() {
+        static ObjectPool* pool = new ObjectPool;
+        return *pool;
+    }
+
+    T* acquire() {
+        LocalCache& cache = localCache();
+        if (cache.free.empty()) {
+            refill(cache);
+        }
+        T* record = cache.free.back();
+        cache.free.pop_back();
+        return record;
+    }
+
+    void release(T* record) {
+        LocalCache& cache = localCache();
+        cache.free.push_back(record);
+        if (cache.free.size() >= 2 * BATCH_SIZE) {
+            flush(cache, BATCH_SIZE);
+        }
+    }
+
+    // Return a record straight to the shared list, bypassing the calling
+    // thread's cache. For teardown paths, where that cache may already have
+    // been destroyed (e.g. static destructors running after exit()).
+    void releaseShared(T* record) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shared_.push_back(record);
+    }
+
+    // Number of times the pool had to go to the global allocator.
+    // Stays constant in steady state.
+    size_t getSlabAllocations() const {
+        return slabAllocations_;
+    }
+
+    size_t getCapacity() const {
+        return slabAllocations_ * SLAB_SIZE;
+    }
+
+private:
+    struct LocalCache {
+        std::vector<T*> free;
+
+        LocalCache() {
+            free.reserve(2 * BATCH_SIZE);
+        }
+
+        // Hand cached records back when the owning thread exits
+        ~LocalCache() {
+            ObjectPool::instance().flush(*this, free.size());
+        }
+    };
+
+    std::vector<std::unique_ptr<T[]>> slabs_;
+    std::vector<T*> shared_;
+    std::mutex mutex_;
+    std::atomic<size_t> slabAllocations_;
+
+    ObjectPool() : slabAllocations_(0) {}
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    static LocalCache& localCache() {
+        thread_local LocalCache cache;
+        return cache;
+    }
+
+    void refill(LocalCache& cache) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (shared_.empty()) {
+            slabs_.emplace_back(new T[SLAB_SIZE]);
+            slabAllocations_++;
+
+            // Reserve room for every record so later flushes never reallocate
+            T* slab = slabs_.back().get();
+            shared_.reserve(slabs_.size() * SLAB_SIZE);
+            for (size_t i = 0; i < SLAB_SIZE; ++i) {
+                shared_.push_back(&slab[i]);
+            }
+        }
+
+        size_t count = std::min(BATCH_SIZE, shared_.size());
+        cache.free.insert(cache.free.end(), shared_.end() - count, shared_.end());
+        shared_.resize(shared_.size() - count);
+    }
+
+    void flush(LocalCache& cache, size_t count) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shared_.insert(shared_.end(), cache.free.end() - count, cache.free.end());
+        cache.free.resize(cache.free.size() - count);
+    }
+};
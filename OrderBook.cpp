@@ -0,0 +1,168 @@
+#include "OrderBook.h"
+#include <cmath>
+
+int OrderBook::apply(const MarketData& data) {
+    switch (data.action) {
+        case Action::ADD:
+            return add(data.side, data.price, data.size);
+        case Action::MODIFY:
+            return modify(data.side, data.price, data.size);
+        case Action::DELETE:
+            return remove(data.side, data.price);
+        case Action::TRADE:
+            return trade(data.side, data.price, data.size);
+    }
+    return -1;
+}
+
+int OrderBook::add(Side side, double price, int64_t size) {
+    if (side == Side::NONE || size <= 0) return -1;
+    
+    auto& book = levels(side);
+    int64_t ticks = toTicks(price);
+    size_t index = findLevel(book, side, ticks);
+    
+    if (index < book.size() && book[index].ticks == ticks) {
+        book[index].size += size;
+    } else {
+        book.insert(book.begin() + index, Level{ticks, size});
+    }
+    return depthOf(book, index);
+}
+
+int OrderBook::modify(Side side, double price, int64_t size) {
+    if (side == Side::NONE) return -1;
+    if (size <= 0) return remove(side, price);
+    
+    auto& book = levels(side);
+    int64_t ticks = toTicks(price);
+    size_t index = findLevel(book, side, ticks);
+    
+    if (index < book.size() && book[index].ticks == ticks) {
+        book[index].size = size;
+    } else {
+        book.insert(book.begin() + index, Level{ticks, size});
+    }
+    return depthOf(book, index);
+}
+
+int OrderBook::remove(Side side, double price) {
+    if (side == Side::NONE) return -1;
+    
+    auto& book = levels(side);
+    int64_t ticks = toTicks(price);
+    size_t index = findLevel(book, side, ticks);
+    
+    if (index < book.size() && book[index].ticks == ticks) {
+        int depth = depthOf(book, index);
+        book.erase(book.begin() + index);
+        return depth;
+    }
+    return -1;
+}
+
+int OrderBook::trade(Side side, double price, int64_t size) {
+    lastTradePrice_ = price;
+    if (side == Side::NONE) return -1;
+    
+    auto& book = levels(side);
+    int64_t ticks = toTicks(price);
+    size_t index = findLevel(book, side, ticks);
+    
+    if (index < book.size() && book[index].ticks == ticks) {
+        int depth = depthOf(book, index);
+        book[index].size -= size;
+        if (book[index].size <= 0) {
+            book.erase(book.begin() + index);
+        }
+        return depth;
+    }
+    return -1;
+}
+
+void OrderBook::snapshot(size_t depth, BookSnapshot& out) const {
+    out.bids.clear();
+    out.asks.clear();
+    
+    for (size_t i = 0; i < depth && i < bids_.size(); ++i) {
+        const Level& level = bids_[bids_.size() - 1 - i];
+        out.bids.push_back(BookLevel{toPrice(level.ticks), level.size});
+    }
+    for (size_t i = 0; i < depth && i < asks_.size(); ++i) {
+        const Level& level = asks_[asks_.size() - 1 - i];
+        out.asks.push_back(BookLevel{toPrice(level.ticks), level.size});
+    }
+}
+
+size_t OrderBook::levelCount(Side side) const {
+    if (side == Side::NONE) return 0;
+    return levels(side).size();
+}
+
+bool OrderBook::bestBid(BookLevel& level) const {
+    if (bids_.empty()) return false;
+    level = BookLevel{toPrice(bids_.back().ticks), bids_.back().size};
+    return true;
+}
+
+bool OrderBook::bestAsk(BookLevel& level) const {
+    if (asks_.empty()) return false;
+    level = BookLevel{toPrice(asks_.back().ticks), asks_.back().size};
+    return true;
+}
+
+double OrderBook::getLastTradePrice() const {
+    return lastTradePrice_;
+}
+
+std::vector<OrderBook::Level>& OrderBook::levels(Side side) {
+    return side == Side::BID ? bids_ : asks_;
+}
+
+const std::vector<OrderBook::Level>& OrderBook::levels(Side side) const {
+    return side == Side::BID ? bids_ : asks_;
+}
+
+size_t OrderBook::findLevel(const std::vector<Level>& levels, Side side, int64_t ticks) const {
+    // Updates cluster at the top of the book, so check the last few levels
+    // before falling back to a binary search over the whole side
+    bool ascending = side == Side::BID;
+    auto before = [ascending](int64_t a, int64_t b) { return ascending ? a < b : a > b; };
+    
+    size_t n = levels.size();
+    size_t scanned = 0;
+    size_t index = n;
+    while (index > 0 && scanned < 4 && before(ticks, levels[index - 1].ticks)) {
+        --index;
+        ++scanned;
+    }
+    if (index == 0 || !before(ticks, levels[index - 1].ticks)) {
+        // Either found the slot or ticks >= levels[index - 1]
+        if (index > 0 && levels[index - 1].ticks == ticks) return index - 1;
+        return index;
+    }
+    
+    size_t lo = 0;
+    size_t hi = index;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (before(levels[mid].ticks, ticks)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+int OrderBook::depthOf(const std::vector<Level>& levels, size_t index) {
+    return static_cast<int>(levels.size() - 1 - index);
+}
+
+int64_t OrderBook::toTicks(double price) {
+    return std::llround(price * PRICE_SCALE);
+}
+
+double OrderBook::toPrice(int64_t ticks) {
+    return ticks / PRICE_SCALE;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "FeedHandler.h"
+
+// Aggregated price level as published in depth snapshots
+struct BookLevel {
+    double price;
+    int64_t size;
+};
+
+// Top-N depth for one symbol, best level first on each side
+struct BookSnapshot {
+    std::string symbol;
+    std::string timestamp;
+    std::vector<BookLevel> bids;
+    std::vector<BookLevel> asks;
+};
+
+// L2 price-level book for a single symbol.
+//
+// Each side is a flat array of (price in ticks, size) kept sorted so that the
+// best level is at the back. Most activity happens near the top of the book,
+// so inserts and deletes only shift the few levels above the touched one,
+// and lookups are a binary search over contiguous memory.
+//
+// Event semantics (per price level, size is aggregate quantity):
+//   ADD    - add size to the level, creating it if needed
+//   MODIFY - set the level's size (0 removes it)
+//   DELETE - remove the level
+//   TRADE  - reduce the resting level on the given side by the traded size;
+//            trades without a side only update the last trade
+class OrderBook {
+public:
+    // Prices are stored as integer ticks of 1/PRICE_SCALE
+    static constexpr double PRICE_SCALE = 10000.0;
+
+    // All updates return how far from the top of its side the touched level
+    // was (0 = best), or -1 if no level was affected
+    int apply(const MarketData& data);
+
+    int add(Side side, double price, int64_t size);
+    int modify(Side side, double price, int64_t size);
+    int remove(Side side, double price);
+    int trade(Side side, double price, int64_t size);
+
+    // Copy up to `depth` levels per side into the snapshot, best first
+    void snapshot(size_t depth, BookSnapshot& out) const;
+
+    size_t levelCount(Side side) const;
+    bool bestBid(BookLevel& level) const;
+    bool bestAsk(BookLevel& level) const;
+    double getLastTradePrice() const;
+
+private:
+    struct Level {
+        int64_t ticks;
+        int64_t size;
+    };
+
+    // Bids ascending, asks descending: best level is always back()
+    std::vector<Level> bids_;
+    std::vector<Level> asks_;
+    double lastTradePrice_ = 0.0;
+
+    std::vector<Level>& levels(Side side);
+    const std::vector<Level>& levels(Side side) const;
+
+    // Index of the level at `ticks`, or where it would be inserted
+    size_t findLevel(const std::vector<Level>& levels, Side side, int64_t ticks) const;
+
+    // Depth from the top for the level at `index`
+    static int depthOf(const std::vector<Level>& levels, size_t index);
+
+    static int64_t toTicks(double price);
+    static double toPrice(int64_t ticks);
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <string>
+#include <tuple>
+#include <utility>
+#include <iostream>
+#include <exception>
+#include <cstddef>
+#include "FeedHandler.h"
+
+// Compile-time specialized tick pipeline.
+//
+// The parser and the subscriber list are template parameters, so delivery
+// is a fold over a std::tuple: no std::function, no subscriber map and no
+// queue hop. Every onMarketData call is a direct call the compiler can
+// inline. The subscribers are held by value, one after another, inside the
+// pipeline object. Everything runs on the calling thread, and a Pipeline
+// is not thread-safe.
+//
+// Parser: callable as bool(const std::string& line, MarketData& data)
+// Subscribers: default-constructible, with void onMarketData(const MarketData&)
+
+// Default parser policy: the feed handler's CSV format
+struct CsvParser {
+    bool operator()(const std::string& line, MarketData& data) const {
+        return FeedHandler::parseMarketData(line, data);
+    }
+};
+
+template <typename Parser, typename... Subscribers>
+class Pipeline {
+public:
+    static_assert(sizeof...(Subscribers) > 0, "Pipeline needs at least one subscriber");
+
+    static constexpr size_t SUBSCRIBER_COUNT = sizeof...(Subscribers);
+
+    // Parse one feed line and deliver it; false if the parser rejected it
+    bool processLine(const std::string& line) {
+        if (!parser_(line, scratch_)) {
+            parseErrors_++;
+            return false;
+        }
+        publish(scratch_);
+        return true;
+    }
+
+    // Deliver an already parsed message to every subscriber, in order
+    void publish(const MarketData& data) {
+        deliver(data, std::index_sequence_for<Subscribers...>{});
+        messagesProcessed_++;
+    }
+
+    // Access a subscriber by type (the type must appear once in the list)
+    template <typename Subscriber>
+    Subscriber& get() { return std::get<Subscriber>(subscribers_); }
+
+    template <typename Subscriber>
+    const Subscriber& get() const { return std::get<Subscriber>(subscribers_); }
+
+    Parser& parser() { return parser_; }
+
+    // Statistics
+    size_t getMessagesProcessed() const { return messagesProcessed_; }
+    size_t getParseErrors() const { return parseErrors_; }
+    size_t getSubscriberErrors(size_t index) const { return errors_[index]; }
+
+private:
+    Parser parser_;
+    std::tuple<Subscribers...> subscribers_;
+    MarketData scratch_; // Reused so steady-state parsing does not allocate
+
+    size_t messagesProcessed_ = 0;
+    size_t parseErrors_ = 0;
+    size_t errors_[sizeof...(Subscribers)] = {};
+
+    template <size_t... Index>
+    void deliver(const MarketData& data, std::index_sequence<Index...>) {
+        (deliverTo<Index>(data), ...);
+    }
+
+    // Same isolation as the broker: one failing subscriber doesn't starve the rest
+    template <size_t Index>
+    void deliverTo(const MarketData& data) {
+        try {
+            std::get<Index>(subscribers_).onMarketData(data);
+        } catch (const std::exception& e) {
+            errors_[Index]++;
+            std::cerr << "Error in subscriber callback: " << e.what() << std::endl;
+        }
+    }
+};
@@ -0,0 +1,296 @@
+#include "SharedMemoryRing.h"
+#include "Timestamp.h"
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static size_t ringSize(uint32_t slotCount) {
+    return sizeof(ShmRingHeader) + static_cast<size_t>(slotCount) * sizeof(ShmSlot);
+}
+
+// Shared Memory Publisher Implementation
+SharedMemoryPublisher::SharedMemoryPublisher()
+    : header_(nullptr), slots_(nullptr), mappedSize_(0), mask_(0) {}
+
+SharedMemoryPublisher::~SharedMemoryPublisher() {
+    close();
+}
+
+// Mark an existing ring as retired and unlink it, so attached readers
+// reattach instead of seeing the segment resized underneath them
+static void retireRing(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) return;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(ShmRingHeader)) {
+        void* addr = mmap(nullptr, sizeof(ShmRingHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED) {
+            static_cast<ShmRingHeader*>(addr)->magic.store(0, std::memory_order_release);
+            munmap(addr, sizeof(ShmRingHeader));
+        }
+    }
+    ::close(fd);
+    shm_unlink(name.c_str());
+}
+
+bool SharedMemoryPublisher::open(const std::string& name, uint32_t slotCount) {
+    close();
+
+    if (slotCount == 0 || (slotCount & (slotCount - 1)) != 0) {
+        std::cerr << "Shared memory ring size must be a power of two" << std::endl;
+        return false;
+    }
+
+    retireRing(name);
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "shm_open failed for " << name << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    // A fresh segment is zero-filled, so readers see magic 0 until it is ready
+    size_t size = ringSize(slotCount);
+    if (ftruncate(fd, size) != 0) {
+        std::cerr << "ftruncate failed for " << name << ": " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        std::cerr << "mmap failed for " << name << ": " << std::strerror(errno) << std::endl;
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    header_ = static_cast<ShmRingHeader*>(addr);
+    slots_ = reinterpret_cast<ShmSlot*>(static_cast<char*>(addr) + sizeof(ShmRingHeader));
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        new (&slots_[i].sequence) std::atomic<uint64_t>(0);
+    }
+    new (&header_->writeSequence) std::atomic<uint64_t>(0);
+    new (&header_->epoch) std::atomic<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    header_->version = VERSION;
+    header_->slotCount = slotCount;
+    header_->magic.store(MAGIC, std::memory_order_release);
+
+    name_ = name;
+    mappedSize_ = size;
+    mask_ = slotCount - 1;
+
+    std::cout << "Shared memory ring " << name << " ready (" << slotCount << " slots)" << std::endl;
+    return true;
+}
+
+void SharedMemoryPublisher::close() {
+    if (!header_) return;
+
+    // Leave the segment in place so attached readers can drain it
+    munmap(header_, mappedSize_);
+    header_ = nullptr;
+    slots_ = nullptr;
+    mappedSize_ = 0;
+}
+
+void SharedMemoryPublisher::publish(const MarketData& data) {
+    if (!header_) return;
+
+    ShmTick tick{};
+    std::strncpy(tick.symbol, data.symbol.c_str(), sizeof(tick.symbol) - 1);
+    tick.price = data.price;
+    if (!parseTimestamp(data.timestamp, tick.timestampNanos)) {
+        tick.timestampNanos = 0;
+    }
+    tick.size = data.size;
+    tick.side = static_cast<uint8_t>(data.side);
+    tick.action = static_cast<uint8_t>(data.action);
+
+    uint64_t sequence = header_->writeSequence.load(std::memory_order_relaxed);
+    ShmSlot& slot = slots_[sequence & mask_];
+
+    // Seqlock: mark the slot busy, fill it, then stamp it with its sequence
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.tick = tick;
+    slot.sequence.store(sequence + 1, std::memory_order_release);
+    header_->writeSequence.store(sequence + 1, std::memory_order_release);
+}
+
+uint64_t SharedMemoryPublisher::getPublished() const {
+    return header_ ? header_->writeSequence.load(std::memory_order_relaxed) : 0;
+}
+
+// Shared Memory Reader Implementation
+SharedMemoryReader::SharedMemoryReader()
+    : header_(nullptr), slots_(nullptr), mappedSize_(0), mask_(0),
+      epoch_(0), cursor_(0), dropped_(0), scratch_{} {}
+
+SharedMemoryReader::~SharedMemoryReader() {
+    close();
+}
+
+bool SharedMemoryReader::open(const std::string& name) {
+    close();
+
+    if (!attach(name, false)) {
+        return false;
+    }
+    dropped_ = 0;
+    seekToLatest();
+    return true;
+}
+
+void SharedMemoryReader::close() {
+    unmap();
+    name_.clear();
+}
+
+bool SharedMemoryReader::attach(const std::string& name, bool quiet) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        if (!quiet) {
+            std::cerr << "shm_open failed for " << name << ": " << std::strerror(errno) << std::endl;
+        }
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmRingHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) return false;
+
+    const ShmRingHeader* header = static_cast<const ShmRingHeader*>(addr);
+    if (header->magic.load(std::memory_order_acquire) != SharedMemoryPublisher::MAGIC ||
+        header->version != SharedMemoryPublisher::VERSION ||
+        header->slotCount == 0 || (header->slotCount & (header->slotCount - 1)) != 0 ||
+        ringSize(header->slotCount) > static_cast<size_t>(st.st_size)) {
+        if (!quiet) {
+            std::cerr << "Not a tick ring (or writer still initializing): " << name << std::endl;
+        }
+        munmap(addr, st.st_size);
+        return false;
+    }
+
+    name_ = name;
+    header_ = header;
+    slots_ = reinterpret_cast<const ShmSlot*>(static_cast<const char*>(addr) + sizeof(ShmRingHeader));
+    mappedSize_ = st.st_size;
+    mask_ = header->slotCount - 1;
+    epoch_ = header->epoch.load(std::memory_order_relaxed);
+    return true;
+}
+
+void SharedMemoryReader::unmap() {
+    if (!header_) return;
+
+    munmap(const_cast<ShmRingHeader*>(header_), mappedSize_);
+    header_ = nullptr;
+    slots_ = nullptr;
+    mappedSize_ = 0;
+}
+
+SharedMemoryReader::ReadResult SharedMemoryReader::read(ShmTick& tick) {
+    if (!header_) {
+        // Waiting for a replaced ring to come up; retried on every read
+        if (name_.empty() || !attach(name_, true)) return ReadResult::EMPTY;
+        cursor_ = 0;
+    }
+
+    // Recreated in place: the slots belong to another ring now
+    if (header_->epoch.load(std::memory_order_relaxed) != epoch_) {
+        unmap();
+        return ReadResult::EMPTY;
+    }
+
+    // Retired: the old mapping stays valid until we drop it, so finish the
+    // ticks its writer published, then map the replacement afresh (it may
+    // have a different size)
+    bool retired = header_->magic.load(std::memory_order_acquire) != SharedMemoryPublisher::MAGIC;
+    uint64_t published = header_->writeSequence.load(std::memory_order_acquire);
+    if (cursor_ >= published) {
+        if (retired) unmap();
+        return ReadResult::EMPTY;
+    }
+
+    uint64_t capacity = mask_ + 1;
+    if (published - cursor_ > capacity) {
+        uint64_t oldest = published - capacity;
+        dropped_ += oldest - cursor_;
+        cursor_ = oldest;
+        return ReadResult::OVERRUN;
+    }
+
+    const ShmSlot& slot = slots_[cursor_ & mask_];
+    uint64_t before = slot.sequence.load(std::memory_order_acquire);
+    tick = slot.tick;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t after = slot.sequence.load(std::memory_order_relaxed);
+
+    if (before != cursor_ + 1 || after != before) {
+        // Writer lapped us while we were copying this slot
+        uint64_t latest = header_->writeSequence.load(std::memory_order_acquire);
+        uint64_t oldest = latest > capacity ? latest - capacity + 1 : 0;
+        uint64_t next = std::max(oldest, cursor_ + 1);
+        dropped_ += next - cursor_;
+        cursor_ = next;
+        return ReadResult::OVERRUN;
+    }
+
+    cursor_++;
+    return ReadResult::OK;
+}
+
+SharedMemoryReader::ReadResult SharedMemoryReader::read(MarketData& data) {
+    ReadResult result = read(scratch_);
+    if (result == ReadResult::OK) {
+        data.symbol.assign(scratch_.symbol);
+        data.price = scratch_.price;
+        data.size = scratch_.size;
+        // Nanosecond precision, formatted in place; 0 means the feed's
+        // timestamp did not parse
+        if (scratch_.timestampNanos != 0) {
+            formatTimestampNanos(scratch_.timestampNanos, data.timestamp);
+        } else {
+            data.timestamp.clear();
+        }
+        data.side = static_cast<Side>(scratch_.side);
+        data.action = static_cast<Action>(scratch_.action);
+    }
+    return result;
+}
+
+void SharedMemoryReader::seekToLatest() {
+    if (!header_) return;
+    cursor_ = header_->writeSequence.load(std::memory_order_acquire);
+}
+
+uint64_t SharedMemoryReader::getCursor() const {
+    return cursor_;
+}
+
+uint64_t SharedMemoryReader::getDropped() const {
+    return dropped_;
+}
+
+uint64_t SharedMemoryReader::getBacklog() const {
+    if (!header_) return 0;
+    uint64_t published = header_->writeSequence.load(std::memory_order_acquire);
+    return published > cursor_ ? published - cursor_ : 0;
+}
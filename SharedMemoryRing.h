@@ -0,0 +1,121 @@
+#pragma once
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include "FeedHandler.h"
+
+// Shared-memory multicast ring for normalized ticks.
+//
+// One writer process publishes into a POSIX shared memory segment; any
+// number of reader processes map it read-only and each keeps its own
+// cursor. The writer never waits for readers: a slow reader that falls more
+// than a ring's length behind is overrun and skips ahead, counting what it
+// lost. Each slot is a seqlock (the slot's sequence number is cleared while
+// the writer fills it), so readers detect torn or overwritten records
+// without any locking.
+//
+// A restarted writer never resizes a ring in place: it clears the old
+// segment's magic, unlinks it and creates a fresh one under the same name.
+// Readers keep a valid (if stale) mapping until they notice and reattach.
+
+// Normalized tick as stored in the ring; fixed-size and trivially copyable
+struct ShmTick {
+    char symbol[16];        // NUL-terminated, truncated to 15 characters
+    double price;
+    int64_t timestampNanos; // Tick time since epoch, 0 if unparseable
+    int32_t size;
+    uint8_t side;           // Side
+    uint8_t action;         // Action
+};
+
+struct alignas(64) ShmSlot {
+    std::atomic<uint64_t> sequence; // Sequence + 1 of the stored tick, 0 while writing
+    ShmTick tick;
+};
+
+struct ShmRingHeader {
+    std::atomic<uint64_t> magic;    // MAGIC when live, 0 while initializing or retired
+    uint32_t version;
+    uint32_t slotCount;             // Power of two
+    std::atomic<int64_t> epoch;     // Changes whenever the writer recreates the ring
+    alignas(64) std::atomic<uint64_t> writeSequence; // Next sequence to publish
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<int64_t>::is_always_lock_free,
+              "shared-memory ring needs lock-free 64-bit atomics");
+
+// Writer side: a publisher backend that puts MarketData into the ring.
+// The ring has a single writer: publish() must always be called from the
+// same thread (the feed handler's network thread).
+class SharedMemoryPublisher {
+public:
+    static constexpr uint64_t MAGIC = 0x474e49524b434954ULL; // "TICKRING"
+    static constexpr uint32_t VERSION = 2;
+
+    SharedMemoryPublisher();
+    ~SharedMemoryPublisher();
+
+    // Create (or replace) the segment, e.g. name "/feedhandler_ticks"
+    bool open(const std::string& name, uint32_t slotCount = 65536);
+    void close();
+
+    // Single-writer; no locking
+    void publish(const MarketData& data);
+
+    uint64_t getPublished() const;
+
+private:
+    std::string name_;
+    ShmRingHeader* header_;
+    ShmSlot* slots_;
+    size_t mappedSize_;
+    uint64_t mask_;
+};
+
+// Reader side: attach to a ring and consume it at the reader's own pace
+class SharedMemoryReader {
+public:
+    enum class ReadResult {
+        OK,         // A tick was read
+        EMPTY,      // Caught up with the writer
+        OVERRUN     // Fell behind; cursor moved to the oldest available tick
+    };
+
+    SharedMemoryReader();
+    ~SharedMemoryReader();
+
+    // Attach to an existing ring; starts at the latest tick
+    bool open(const std::string& name);
+    void close();
+
+    // If the writer replaced the ring, finishes the old ring's published
+    // ticks, then reattaches by name (re-validating it) and continues from
+    // the new ring's first tick
+    ReadResult read(ShmTick& tick);
+
+    // Same, converted to MarketData with a nanosecond-precision timestamp
+    // (empty if the feed's timestamp did not parse), reusing its buffers
+    ReadResult read(MarketData& data);
+
+    // Skip everything published so far
+    void seekToLatest();
+
+    uint64_t getCursor() const;
+    uint64_t getDropped() const;
+    uint64_t getBacklog() const;
+
+private:
+    std::string name_;
+    const ShmRingHeader* header_;
+    const ShmSlot* slots_;
+    size_t mappedSize_;
+    uint64_t mask_;
+    int64_t epoch_;
+    uint64_t cursor_;
+    uint64_t dropped_;
+    ShmTick scratch_;
+
+    bool attach(const std::string& name, bool quiet);
+    void unmap();
+};
@@ -0,0 +1,282 @@
+#include "Snapshot.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static const char SNAPSHOT_MAGIC[8] = {'F', 'H', 'S', 'N', 'A', 'P', '0', '1'};
+
+#pragma pack(push, 1)
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t sectionCount;
+    int64_t createdNanos;
+    uint64_t checksum;
+};
+
+struct SectionHeader {
+    uint32_t type;
+    uint32_t length;
+};
+#pragma pack(pop)
+
+static uint64_t fnv1a(const uint8_t* data, size_t size, uint64_t hash = 14695981039346656037ULL) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static int64_t wallClockNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Snapshot Writer Implementation
+void SnapshotWriter::putU32(uint32_t value) {
+    putBytes(&value, sizeof(value));
+}
+
+void SnapshotWriter::putI64(int64_t value) {
+    putBytes(&value, sizeof(value));
+}
+
+void SnapshotWriter::putDouble(double value) {
+    putBytes(&value, sizeof(value));
+}
+
+void SnapshotWriter::putString(const std::string& value) {
+    putU32(static_cast<uint32_t>(value.size()));
+    putBytes(value.data(), value.size());
+}
+
+void SnapshotWriter::clear() {
+    buffer_.clear();
+}
+
+const std::vector<uint8_t>& SnapshotWriter::data() const {
+    return buffer_;
+}
+
+void SnapshotWriter::putBytes(const void* bytes, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(bytes);
+    buffer_.insert(buffer_.end(), p, p + size);
+}
+
+// Snapshot Reader Implementation
+SnapshotReader::SnapshotReader(const uint8_t* data, size_t size)
+    : data_(data), size_(size), pos_(0) {}
+
+bool SnapshotReader::getU32(uint32_t& value) {
+    return getBytes(&value, sizeof(value));
+}
+
+bool SnapshotReader::getI64(int64_t& value) {
+    return getBytes(&value, sizeof(value));
+}
+
+bool SnapshotReader::getDouble(double& value) {
+    return getBytes(&value, sizeof(value));
+}
+
+bool SnapshotReader::getString(std::string& value) {
+    uint32_t length;
+    if (!getU32(length) || length > size_ - pos_) return false;
+    value.assign(reinterpret_cast<const char*>(data_ + pos_), length);
+    pos_ += length;
+    return true;
+}
+
+bool SnapshotReader::getBytes(void* bytes, size_t size) {
+    if (size > size_ - pos_) return false;
+    std::memcpy(bytes, data_ + pos_, size);
+    pos_ += size;
+    return true;
+}
+
+// Snapshot Manager Implementation
+SnapshotManager::SnapshotManager(const std::string& path, std::chrono::milliseconds interval)
+    : path_(path), interval_(interval), running_(false),
+      snapshotTime_(0), snapshotsWritten_(0) {}
+
+SnapshotManager::~SnapshotManager() {
+    stop();
+}
+
+void SnapshotManager::registerSection(SubscriberType type, SaveFunction save, LoadFunction load) {
+    std::lock_guard<std::mutex> lock(saveMutex_);
+    sections_.push_back(Section{type, save, load, SnapshotWriter()});
+}
+
+bool SnapshotManager::restore() {
+    int fd = ::open(path_.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = st.st_size;
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) return false;
+
+    const uint8_t* data = static_cast<const uint8_t*>(addr);
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    const uint8_t* body = data + sizeof(header);
+    size_t bodySize = size - sizeof(header);
+
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+        header.version != VERSION || fnv1a(body, bodySize) != header.checksum) {
+        std::cerr << "Ignoring invalid snapshot: " << path_ << std::endl;
+        munmap(addr, size);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(saveMutex_);
+    size_t offset = 0;
+    bool ok = true;
+
+    for (uint32_t i = 0; i < header.sectionCount && ok; ++i) {
+        SectionHeader section;
+        if (bodySize - offset < sizeof(section)) {
+            ok = false;
+            break;
+        }
+        std::memcpy(&section, body + offset, sizeof(section));
+        offset += sizeof(section);
+        if (section.length > bodySize - offset) {
+            ok = false;
+            break;
+        }
+
+        // Sections without a registered loader are skipped
+        for (auto& registered : sections_) {
+            if (static_cast<uint32_t>(registered.type) == section.type) {
+                SnapshotReader reader(body + offset, section.length);
+                if (!registered.load(reader)) {
+                    std::cerr << "Failed to restore snapshot section " << section.type << std::endl;
+                    ok = false;
+                }
+            }
+        }
+        offset += section.length;
+    }
+
+    munmap(addr, size);
+
+    if (ok) {
+        snapshotTime_ = header.createdNanos;
+    }
+    return ok;
+}
+
+bool SnapshotManager::saveNow() {
+    std::lock_guard<std::mutex> lock(saveMutex_);
+
+    // Capture: each subscriber copies its state under its own lock
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = VERSION;
+    header.sectionCount = static_cast<uint32_t>(sections_.size());
+    header.createdNanos = wallClockNanos();
+    header.checksum = fnv1a(nullptr, 0);
+
+    for (auto& section : sections_) {
+        section.staging.clear();
+        section.save(section.staging);
+
+        SectionHeader sectionHeader{static_cast<uint32_t>(section.type),
+                                    static_cast<uint32_t>(section.staging.data().size())};
+        header.checksum = fnv1a(reinterpret_cast<const uint8_t*>(&sectionHeader),
+                                sizeof(sectionHeader), header.checksum);
+        header.checksum = fnv1a(section.staging.data().data(),
+                                section.staging.data().size(), header.checksum);
+    }
+
+    // Publish: write aside and atomically replace the previous snapshot
+    std::string tmpPath = path_ + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Failed to open snapshot file: " << tmpPath << std::endl;
+            return false;
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& section : sections_) {
+            SectionHeader sectionHeader{static_cast<uint32_t>(section.type),
+                                        static_cast<uint32_t>(section.staging.data().size())};
+            out.write(reinterpret_cast<const char*>(&sectionHeader), sizeof(sectionHeader));
+            out.write(reinterpret_cast<const char*>(section.staging.data().data()),
+                      section.staging.data().size());
+        }
+
+        if (!out.flush()) {
+            std::cerr << "Failed to write snapshot file: " << tmpPath << std::endl;
+            return false;
+        }
+    }
+
+    if (std::rename(tmpPath.c_str(), path_.c_str()) != 0) {
+        std::cerr << "Failed to replace snapshot file: " << path_ << std::endl;
+        return false;
+    }
+
+    snapshotTime_ = header.createdNanos;
+    snapshotsWritten_++;
+    return true;
+}
+
+void SnapshotManager::start() {
+    if (running_) return;
+
+    running_ = true;
+    snapshotThread_ = std::thread(&SnapshotManager::snapshotThreadFunction, this);
+}
+
+void SnapshotManager::stop() {
+    if (!running_) return;
+
+    {
+        std::lock_guard<std::mutex> lock(runMutex_);
+        running_ = false;
+    }
+    runCondition_.notify_all();
+
+    if (snapshotThread_.joinable()) {
+        snapshotThread_.join();
+    }
+}
+
+int64_t SnapshotManager::getSnapshotTime() const {
+    return snapshotTime_;
+}
+
+size_t SnapshotManager::getSnapshotsWritten() const {
+    return snapshotsWritten_;
+}
+
+void SnapshotManager::snapshotThreadFunction() {
+    std::unique_lock<std::mutex> lock(runMutex_);
+
+    while (running_) {
+        if (runCondition_.wait_for(lock, interval_, [this] { return !running_; })) {
+            break;
+        }
+
+        lock.unlock();
+        saveNow();
+        lock.lock();
+    }
+}
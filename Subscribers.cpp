@@ -1,14 +1,22 @@
 #include "Subscribers.h"
+#include "Timestamp.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
+#include <chrono>
 
 // Trading Algorithm Subscriber Implementation
-TradingAlgorithmSubscriber::TradingAlgorithmSubscriber() {
+TradingAlgorithmSubscriber::TradingAlgorithmSubscriber() 
+    : buySignals_(MetricsRegistry::instance().counter(
+          "trading_signals_total", "Signals generated by the trading algorithm", "side=\"buy\"")),
+      sellSignals_(MetricsRegistry::instance().counter(
+          "trading_signals_total", "Signals generated by the trading algorithm", "side=\"sell\"")) {
     std::cout << "Trading Algorithm Subscriber initialized" << std::endl;
 }
 
 void TradingAlgorithmSubscriber::onMarketData(const MarketData& data) {
+    if (data.action != Action::TRADE) return;
+    
     std::lock_guard<std::mutex> lock(symbolsMutex_);
     
     // Check if we're subscribed to this symbol
@@ -44,11 +52,13 @@ void TradingAlgorithmSubscriber::processSignal(const MarketData& data) {
         double deviation = (data.price - movingAvg) / movingAvg * 100;
         
         if (deviation > 2.0) {
+            buySignals_.inc();
             std::cout << "BUY SIGNAL: " << data.symbol 
                       << " Price: " << data.price 
                       << " MA: " << movingAvg 
                       << " Deviation: " << deviation << "%" << std::endl;
         } else if (deviation < -2.0) {
+            sellSignals_.inc();
             std::cout << "SELL SIGNAL: " << data.symbol 
                       << " Price: " << data.price 
                       << " MA: " << movingAvg 
@@ -79,13 +89,56 @@ double TradingAlgorithmSubscriber::calculateMovingAverage(const std::string& sym
     return std::accumulate(start, prices.end(), 0.0) / period;
 }
 
+void TradingAlgorithmSubscriber::saveState(SnapshotWriter& writer) {
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    
+    writer.putU32(static_cast<uint32_t>(priceHistory_.size()));
+    for (const auto& [symbol, prices] : priceHistory_) {
+        writer.putString(symbol);
+        writer.putU32(static_cast<uint32_t>(prices.size()));
+        for (double price : prices) {
+            writer.putDouble(price);
+        }
+    }
+}
+
+bool TradingAlgorithmSubscriber::loadState(SnapshotReader& reader) {
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    
+    uint32_t symbolCount;
+    if (!reader.getU32(symbolCount)) return false;
+    
+    std::string symbol;
+    for (uint32_t i = 0; i < symbolCount; ++i) {
+        uint32_t priceCount;
+        if (!reader.getString(symbol) || !reader.getU32(priceCount)) return false;
+        
+        auto& prices = priceHistory_[symbol];
+        prices.clear();
+        for (uint32_t j = 0; j < priceCount; ++j) {
+            double price;
+            if (!reader.getDouble(price)) return false;
+            prices.push_back(price);
+        }
+    }
+    return true;
+}
+
 // Risk Management Subscriber Implementation
 RiskManagementSubscriber::RiskManagementSubscriber() 
-    : priceDeviationLimit_(10.0), volumeSpikeThreshold_(5.0) {
+    : priceDeviationLimit_(10.0), volumeSpikeThreshold_(5.0),
+      priceDeviationAlerts_(MetricsRegistry::instance().counter(
+          "risk_alerts_total", "Risk checks that fired", "check=\"price_deviation\"")),
+      volumeSpikeAlerts_(MetricsRegistry::instance().counter(
+          "risk_alerts_total", "Risk checks that fired", "check=\"volume_spike\"")),
+      circuitBreakerAlerts_(MetricsRegistry::instance().counter(
+          "risk_alerts_total", "Risk checks that fired", "check=\"circuit_breaker\"")) {
     std::cout << "Risk Management Subscriber initialized" << std::endl;
 }
 
 void RiskManagementSubscriber::onMarketData(const MarketData& data) {
+    if (data.action != Action::TRADE) return;
+    
     checkPriceDeviation(data);
     checkVolumeSpike(data);
     checkCircuitBreaker(data);
@@ -99,6 +152,7 @@ void RiskManagementSubscriber::checkPriceDeviation(const MarketData& data) {
         double deviation = std::abs(data.price - lastPrice) / lastPrice * 100;
         
         if (deviation > priceDeviationLimit_) {
+            priceDeviationAlerts_.inc();
             std::cout << "RISK ALERT: Price deviation " << deviation 
                       << "% for " << data.symbol << std::endl;
         }
@@ -116,6 +170,7 @@ void RiskManagementSubscriber::checkVolumeSpike(const MarketData& data) {
             double volumeRatio = static_cast<double>(data.size) / lastVolume;
             
             if (volumeRatio > volumeSpikeThreshold_) {
+                volumeSpikeAlerts_.inc();
                 std::cout << "RISK ALERT: Volume spike " << volumeRatio 
                           << "x for " << data.symbol << std::endl;
             }
@@ -128,6 +183,7 @@ void RiskManagementSubscriber::checkVolumeSpike(const MarketData& data) {
 void RiskManagementSubscriber::checkCircuitBreaker(const MarketData& data) {
     // Simple circuit breaker logic
     if (data.price <= 0) {
+        circuitBreakerAlerts_.inc();
         std::cout << "CIRCUIT BREAKER: Invalid price for " << data.symbol << std::endl;
     }
 }
@@ -142,33 +198,93 @@ void RiskManagementSubscriber::setVolumeSpikeThreshold(double threshold) {
     volumeSpikeThreshold_ = threshold;
 }
 
+void RiskManagementSubscriber::saveState(SnapshotWriter& writer) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    
+    writer.putU32(static_cast<uint32_t>(lastPrices_.size()));
+    for (const auto& [symbol, price] : lastPrices_) {
+        writer.putString(symbol);
+        writer.putDouble(price);
+    }
+    
+    writer.putU32(static_cast<uint32_t>(lastVolumes_.size()));
+    for (const auto& [symbol, volume] : lastVolumes_) {
+        writer.putString(symbol);
+        writer.putI64(volume);
+    }
+}
+
+bool RiskManagementSubscriber::loadState(SnapshotReader& reader) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    
+    uint32_t count;
+    std::string symbol;
+    
+    if (!reader.getU32(count)) return false;
+    for (uint32_t i = 0; i < count; ++i) {
+        double price;
+        if (!reader.getString(symbol) || !reader.getDouble(price)) return false;
+        lastPrices_[symbol] = price;
+    }
+    
+    if (!reader.getU32(count)) return false;
+    for (uint32_t i = 0; i < count; ++i) {
+        int64_t volume;
+        if (!reader.getString(symbol) || !reader.getI64(volume)) return false;
+        lastVolumes_[symbol] = static_cast<int>(volume);
+    }
+    return true;
+}
+
 // Analytics Subscriber Implementation
 AnalyticsSubscriber::AnalyticsSubscriber() : totalMessages_(0) {
     std::cout << "Analytics Subscriber initialized" << std::endl;
 }
 
 void AnalyticsSubscriber::onMarketData(const MarketData& data) {
+    if (data.action != Action::TRADE) return;
+    
+    // Unparseable timestamps still count, but don't move the watermark
+    int64_t tickNanos;
+    if (!parseTimestamp(data.timestamp, tickNanos)) {
+        tickNanos = 0;
+    }
+    onTrade(data, tickNanos);
+}
+
+void AnalyticsSubscriber::onTrade(const MarketData& data, int64_t tickNanos) {
     std::lock_guard<std::mutex> lock(dataMutex_);
     
-    priceData_[data.symbol].push_back(data.price);
-    volumeData_[data.symbol].push_back(data.size);
+    auto& stats = stats_[data.symbol];
+    if (stats.count == 0) {
+        stats.minPrice = data.price;
+        stats.maxPrice = data.price;
+    } else {
+        stats.minPrice = std::min(stats.minPrice, data.price);
+        stats.maxPrice = std::max(stats.maxPrice, data.price);
+    }
+    stats.priceSum += data.price;
+    stats.totalVolume += data.size;
+    stats.count++;
     totalMessages_++;
     
+    if (tickNanos > stats.lastTickNanos) {
+        stats.lastTickNanos = tickNanos;
+    }
+    
     calculateStatistics(data);
 }
 
 void AnalyticsSubscriber::calculateStatistics(const MarketData& data) {
-    auto& prices = priceData_[data.symbol];
-    auto& volumes = volumeData_[data.symbol];
+    const auto& stats = stats_[data.symbol];
     
-    if (prices.size() % 100 == 0) { // Log every 100 messages
-        double avgPrice = std::accumulate(prices.begin(), prices.end(), 0.0) / prices.size();
-        int totalVolume = std::accumulate(volumes.begin(), volumes.end(), 0);
+    if (stats.count % 100 == 0) { // Log every 100 messages
+        double avgPrice = stats.priceSum / stats.count;
         
         std::cout << "Analytics: " << data.symbol 
                   << " Avg Price: " << avgPrice 
-                  << " Total Volume: " << totalVolume 
-                  << " Messages: " << prices.size() << std::endl;
+                  << " Total Volume: " << stats.totalVolume 
+                  << " Messages: " << stats.count << std::endl;
     }
 }
 
@@ -178,15 +294,14 @@ void AnalyticsSubscriber::generateReports() {
     std::cout << "\n=== ANALYTICS REPORT ===" << std::endl;
     std::cout << "Total Messages Processed: " << totalMessages_ << std::endl;
     
-    for (const auto& [symbol, prices] : priceData_) {
-        if (!prices.empty()) {
-            double avgPrice = std::accumulate(prices.begin(), prices.end(), 0.0) / prices.size();
-            auto minmax = std::minmax_element(prices.begin(), prices.end());
+    for (const auto& [symbol, stats] : stats_) {
+        if (stats.count > 0) {
+            double avgPrice = stats.priceSum / stats.count;
             
             std::cout << symbol << ": Avg=" << avgPrice 
-                      << " Min=" << *minmax.first 
-                      << " Max=" << *minmax.second 
-                      << " Count=" << prices.size() << std::endl;
+                      << " Min=" << stats.minPrice 
+                      << " Max=" << stats.maxPrice 
+                      << " Count=" << stats.count << std::endl;
         }
     }
     std::cout << "========================\n" << std::endl;
@@ -199,9 +314,9 @@ size_t AnalyticsSubscriber::getTotalMessages() const {
 double AnalyticsSubscriber::getAveragePrice(const std::string& symbol) const {
     std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(dataMutex_));
     
-    auto it = priceData_.find(symbol);
-    if (it != priceData_.end() && !it->second.empty()) {
-        return std::accumulate(it->second.begin(), it->second.end(), 0.0) / it->second.size();
+    auto it = stats_.find(symbol);
+    if (it != stats_.end() && it->second.count > 0) {
+        return it->second.priceSum / it->second.count;
     }
     return 0.0;
 }
@@ -209,9 +324,297 @@ double AnalyticsSubscriber::getAveragePrice(const std::string& symbol) const {
 int AnalyticsSubscriber::getTotalVolume(const std::string& symbol) const {
     std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(dataMutex_));
     
-    auto it = volumeData_.find(symbol);
-    if (it != volumeData_.end()) {
-        return std::accumulate(it->second.begin(), it->second.end(), 0);
+    auto it = stats_.find(symbol);
+    if (it != stats_.end()) {
+        return static_cast<int>(it->second.totalVolume);
     }
     return 0;
 }
+
+int64_t AnalyticsSubscriber::getLastTickTime(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(dataMutex_));
+    
+    auto it = stats_.find(symbol);
+    return it != stats_.end() ? it->second.lastTickNanos : 0;
+}
+
+void AnalyticsSubscriber::saveState(SnapshotWriter& writer) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    
+    writer.putI64(static_cast<int64_t>(totalMessages_));
+    writer.putU32(static_cast<uint32_t>(stats_.size()));
+    for (const auto& [symbol, stats] : stats_) {
+        writer.putString(symbol);
+        writer.putDouble(stats.priceSum);
+        writer.putDouble(stats.minPrice);
+        writer.putDouble(stats.maxPrice);
+        writer.putI64(stats.totalVolume);
+        writer.putI64(static_cast<int64_t>(stats.count));
+        writer.putI64(stats.lastTickNanos);
+    }
+}
+
+bool AnalyticsSubscriber::loadState(SnapshotReader& reader) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    
+    int64_t totalMessages;
+    uint32_t symbolCount;
+    if (!reader.getI64(totalMessages) || !reader.getU32(symbolCount)) return false;
+    
+    std::string symbol;
+    for (uint32_t i = 0; i < symbolCount; ++i) {
+        SymbolStats stats;
+        int64_t count;
+        if (!reader.getString(symbol) || !reader.getDouble(stats.priceSum) ||
+            !reader.getDouble(stats.minPrice) || !reader.getDouble(stats.maxPrice) ||
+            !reader.getI64(stats.totalVolume) || !reader.getI64(count) ||
+            !reader.getI64(stats.lastTickNanos)) {
+            return false;
+        }
+        stats.count = static_cast<size_t>(count);
+        stats_[symbol] = stats;
+    }
+    totalMessages_ = static_cast<size_t>(totalMessages);
+    return true;
+}
+
+// Order Book Subscriber Implementation
+OrderBookSubscriber::OrderBookSubscriber(size_t depth) 
+    : depth_(depth), updateCount_(0) {
+    std::cout << "Order Book Subscriber initialized (depth " << depth_ << ")" << std::endl;
+}
+
+void OrderBookSubscriber::onMarketData(const MarketData& data) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    
+    auto& book = books_[data.symbol];
+    int depth = book.apply(data);
+    updateCount_++;
+    
+    // Only publish when the visible part of the book changed
+    if (snapshotCallback_ && depth >= 0 && static_cast<size_t>(depth) < depth_) {
+        snapshot_.symbol.assign(data.symbol);
+        snapshot_.timestamp.assign(data.timestamp);
+        book.snapshot(depth_, snapshot_);
+        snapshotCallback_(snapshot_);
+    }
+}
+
+void OrderBookSubscriber::setSnapshotCallback(SnapshotCallback callback) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    snapshotCallback_ = callback;
+}
+
+void OrderBookSubscriber::setDepth(size_t depth) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    depth_ = depth;
+}
+
+bool OrderBookSubscriber::getSnapshot(const std::string& symbol, BookSnapshot& snapshot) const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    
+    auto it = books_.find(symbol);
+    if (it == books_.end()) {
+        return false;
+    }
+    snapshot.symbol = symbol;
+    it->second.snapshot(depth_, snapshot);
+    return true;
+}
+
+size_t OrderBookSubscriber::getUpdateCount() const {
+    return updateCount_;
+}
+
+void OrderBookSubscriber::generateReports() {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    
+    std::cout << "\n=== ORDER BOOK REPORT ===" << std::endl;
+    std::cout << "Book Updates Processed: " << updateCount_ << std::endl;
+    
+    for (const auto& [symbol, book] : books_) {
+        BookLevel bid{}, ask{};
+        bool hasBid = book.bestBid(bid);
+        bool hasAsk = book.bestAsk(ask);
+        
+        std::cout << symbol << ": Levels=" << book.levelCount(Side::BID) 
+                  << "/" << book.levelCount(Side::ASK);
+        if (hasBid) std::cout << " Bid=" << bid.size << "@" << bid.price;
+        if (hasAsk) std::cout << " Ask=" << ask.size << "@" << ask.price;
+        std::cout << " Last=" << book.getLastTradePrice() << std::endl;
+    }
+    std::cout << "=========================\n" << std::endl;
+}
+
+// Bar Subscriber Implementation
+BarSubscriber::BarSubscriber(const std::vector<int64_t>& intervalSeconds) 
+    : aggregator_(intervalSeconds), barsCompleted_(0), badTimestamps_(0) {
+    aggregator_.setBarCallback([this](const Bar& bar) { onBar(bar); });
+    std::cout << "Bar Subscriber initialized" << std::endl;
+}
+
+void BarSubscriber::onMarketData(const MarketData& data) {
+    if (data.action != Action::TRADE) return;
+    
+    int64_t tickNanos;
+    if (!parseTimestamp(data.timestamp, tickNanos)) {
+        badTimestamps_++;
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    aggregator_.onTrade(data.symbol, tickNanos, data.price, data.size);
+}
+
+void BarSubscriber::addBarCallback(BarCallback callback) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    callbacks_.push_back(callback);
+}
+
+bool BarSubscriber::enableBarFile(const std::string& path) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    if (!barFile_.open(path)) {
+        return false;
+    }
+    std::cout << "Writing bars to: " << path << std::endl;
+    return true;
+}
+
+void BarSubscriber::flush() {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    aggregator_.flush();
+    barFile_.flush();
+}
+
+size_t BarSubscriber::getBarsCompleted() const {
+    return barsCompleted_;
+}
+
+size_t BarSubscriber::getBadTimestamps() const {
+    return badTimestamps_;
+}
+
+void BarSubscriber::onBar(const Bar& bar) {
+    // Called by the aggregator with dataMutex_ held
+    barsCompleted_++;
+    
+    for (const auto& callback : callbacks_) {
+        try {
+            callback(bar);
+        } catch (const std::exception& e) {
+            std::cerr << "Error in bar callback: " << e.what() << std::endl;
+        }
+    }
+    barFile_.append(bar);
+}
+
+// Tick Store Subscriber Implementation
+TickStoreSubscriber::TickStoreSubscriber(const std::string& root, TickEncoding encoding) 
+    : writer_(root, encoding), running_(false), ticksWritten_(0), 
+      bytesWritten_(0), badTimestamps_(0), badSymbols_(0) {
+    std::cout << "Tick Store Subscriber initialized, writing to: " << root << std::endl;
+}
+
+TickStoreSubscriber::~TickStoreSubscriber() {
+    stop();
+}
+
+void TickStoreSubscriber::onMarketData(const MarketData& data) {
+    if (data.action != Action::TRADE) return;
+    
+    // Symbols name directories in the store
+    if (!isValidTickSymbol(data.symbol)) {
+        badSymbols_++;
+        return;
+    }
+    
+    StoredTick tick;
+    if (!parseTimestamp(data.timestamp, tick.nanos)) {
+        badTimestamps_++;
+        return;
+    }
+    tick.price = data.price;
+    tick.size = data.size;
+    
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pending_.push_back(PendingTick{data.symbol, tick});
+        wake = pending_.size() >= TickStoreWriter::BLOCK_TICKS;
+    }
+    if (wake) {
+        pendingCondition_.notify_one();
+    }
+}
+
+void TickStoreSubscriber::start() {
+    if (running_) return;
+    
+    running_ = true;
+    writerThread_ = std::thread(&TickStoreSubscriber::writerThreadFunction, this);
+}
+
+void TickStoreSubscriber::stop() {
+    if (!running_) return;
+    
+    running_ = false;
+    pendingCondition_.notify_all();
+    
+    if (writerThread_.joinable()) {
+        writerThread_.join();
+    }
+    
+    std::cout << "Tick store stopped: " << ticksWritten_ << " ticks, " 
+              << bytesWritten_ << " bytes" << std::endl;
+}
+
+size_t TickStoreSubscriber::getTicksWritten() const {
+    return ticksWritten_;
+}
+
+size_t TickStoreSubscriber::getBytesWritten() const {
+    return bytesWritten_;
+}
+
+size_t TickStoreSubscriber::getBadTimestamps() const {
+    return badTimestamps_;
+}
+
+size_t TickStoreSubscriber::getBadSymbols() const {
+    return badSymbols_;
+}
+
+void TickStoreSubscriber::writerThreadFunction() {
+    bool draining = true;
+    auto lastFlush = std::chrono::steady_clock::now();
+    
+    while (draining) {
+        {
+            std::unique_lock<std::mutex> lock(pendingMutex_);
+            
+            // Wake on a full block's worth of ticks, on stop, or every 100ms
+            pendingCondition_.wait_for(lock, std::chrono::milliseconds(100), [this] { 
+                return pending_.size() >= TickStoreWriter::BLOCK_TICKS || !running_; 
+            });
+            
+            // One last pass after stop to drain what is left
+            draining = running_;
+            pending_.swap(writing_);
+        }
+        
+        for (const auto& pending : writing_) {
+            writer_.append(pending.symbol, pending.tick);
+        }
+        writing_.clear();
+        
+        // Bound how long a tick can sit in a partial block
+        auto now = std::chrono::steady_clock::now();
+        if (!draining || now - lastFlush >= std::chrono::seconds(1)) {
+            writer_.flush();
+            lastFlush = now;
+        }
+        
+        ticksWritten_ = writer_.getTicksWritten();
+        bytesWritten_ = writer_.getBytesWritten();
+    }
+}
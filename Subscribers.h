@@ -1,9 +1,19 @@
 #pragma once
 #include "FeedHandler.h"
+#include "OrderBook.h"
+#include "BarAggregator.h"
+#include "BarFileWriter.h"
+#include "TickStore.h"
+#include "Snapshot.h"
+#include "Metrics.h"
 #include <iostream>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <functional>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 
 // Trading Algorithm Subscriber
 class TradingAlgorithmSubscriber {
@@ -16,10 +26,17 @@ public:
     // Trading logic
     void processSignal(const MarketData& data);
     
+    // Warm-start state (price windows)
+    void saveState(SnapshotWriter& writer);
+    bool loadState(SnapshotReader& reader);
+    
 private:
     std::vector<std::string> subscribedSymbols_;
     std::mutex symbolsMutex_;
     
+    Counter& buySignals_;
+    Counter& sellSignals_;
+    
     // Simple moving average for signal generation
     std::map<std::string, std::vector<double>> priceHistory_;
     std::mutex historyMutex_;
@@ -43,11 +60,19 @@ public:
     void setPriceDeviationLimit(double limit);
     void setVolumeSpikeThreshold(double threshold);
     
+    // Warm-start state (last prices and volumes)
+    void saveState(SnapshotWriter& writer);
+    bool loadState(SnapshotReader& reader);
+    
 private:
     double priceDeviationLimit_;
     double volumeSpikeThreshold_;
     std::mutex limitsMutex_;
     
+    Counter& priceDeviationAlerts_;
+    Counter& volumeSpikeAlerts_;
+    Counter& circuitBreakerAlerts_;
+    
     // Track previous prices for deviation calculation
     std::map<std::string, double> lastPrices_;
     std::map<std::string, int> lastVolumes_;
@@ -60,6 +85,10 @@ public:
     AnalyticsSubscriber();
     void onMarketData(const MarketData& data);
     
+    // Fold in a trade whose tick time is already known (e.g. replayed from
+    // the tick store), at full precision and without reparsing data.timestamp
+    void onTrade(const MarketData& data, int64_t tickNanos);
+    
     // Analytics functions
     void calculateStatistics(const MarketData& data);
     void generateReports();
@@ -69,9 +98,134 @@ public:
     double getAveragePrice(const std::string& symbol) const;
     int getTotalVolume(const std::string& symbol) const;
     
+    // Latest tick time folded into the symbol's aggregates, 0 if none;
+    // warm starts backfill strictly after it
+    int64_t getLastTickTime(const std::string& symbol) const;
+    
+    // Warm-start state (per-symbol aggregates)
+    void saveState(SnapshotWriter& writer);
+    bool loadState(SnapshotReader& reader);
+    
 private:
-    std::map<std::string, std::vector<double>> priceData_;
-    std::map<std::string, std::vector<int>> volumeData_;
+    // Running per-symbol aggregates, updated in O(1) without growing storage
+    struct SymbolStats {
+        double priceSum = 0.0;
+        double minPrice = 0.0;
+        double maxPrice = 0.0;
+        int64_t totalVolume = 0;
+        size_t count = 0;
+        int64_t lastTickNanos = 0;
+    };
+    
+    std::map<std::string, SymbolStats> stats_;
     std::atomic<size_t> totalMessages_;
     std::mutex dataMutex_;
 };
+
+// Order Book Subscriber
+// Rebuilds per-symbol L2 books from add/modify/delete/trade events and
+// publishes top-N depth whenever an update touches those levels.
+// Book events must be applied in feed order.
+class OrderBookSubscriber {
+public:
+    using SnapshotCallback = std::function<void(const BookSnapshot&)>;
+    
+    explicit OrderBookSubscriber(size_t depth = 5);
+    void onMarketData(const MarketData& data);
+    
+    // Snapshot publication (invoked on the delivering thread, under the book
+    // lock: copy the snapshot out and format or write it elsewhere)
+    void setSnapshotCallback(SnapshotCallback callback);
+    void setDepth(size_t depth);
+    
+    // Queries
+    bool getSnapshot(const std::string& symbol, BookSnapshot& snapshot) const;
+    size_t getUpdateCount() const;
+    void generateReports();
+    
+private:
+    size_t depth_;
+    std::unordered_map<std::string, OrderBook> books_;
+    SnapshotCallback snapshotCallback_;
+    BookSnapshot snapshot_; // Reused between publications
+    std::atomic<size_t> updateCount_;
+    mutable std::mutex dataMutex_;
+};
+
+// Bar Subscriber
+// Builds 1s/1m/5m (configurable) OHLCV+VWAP bars from trades on tick time
+// and fans completed bars out to downstream callbacks and, optionally, a
+// columnar bar file.
+class BarSubscriber {
+public:
+    using BarCallback = BarAggregator::BarCallback;
+    
+    explicit BarSubscriber(const std::vector<int64_t>& intervalSeconds = {1, 60, 300});
+    void onMarketData(const MarketData& data);
+    
+    // Downstream consumers of completed bars (invoked on the delivering thread)
+    void addBarCallback(BarCallback callback);
+    
+    // Persist completed bars; returns false if the file cannot be opened
+    bool enableBarFile(const std::string& path);
+    
+    // Close open bars and flush the bar file
+    void flush();
+    
+    size_t getBarsCompleted() const;
+    size_t getBadTimestamps() const;
+    
+private:
+    BarAggregator aggregator_;
+    BarFileWriter barFile_;
+    std::vector<BarCallback> callbacks_;
+    std::atomic<size_t> barsCompleted_;
+    std::atomic<size_t> badTimestamps_;
+    std::mutex dataMutex_;
+    
+    void onBar(const Bar& bar);
+};
+
+// Tick Store Subscriber
+// Write-behind persistence of trades: the delivering thread only appends to
+// an in-memory buffer; a background thread swaps it out and encodes it into
+// per-symbol, per-day segments via TickStoreWriter.
+class TickStoreSubscriber {
+public:
+    explicit TickStoreSubscriber(const std::string& root, 
+                                 TickEncoding encoding = TickEncoding::DELTA_VARINT);
+    ~TickStoreSubscriber();
+    
+    void onMarketData(const MarketData& data);
+    
+    void start();
+    void stop(); // Drains the buffer and flushes all segments
+    
+    size_t getTicksWritten() const;
+    size_t getBytesWritten() const;
+    size_t getBadTimestamps() const;
+    size_t getBadSymbols() const;
+    
+private:
+    struct PendingTick {
+        std::string symbol;
+        StoredTick tick;
+    };
+    
+    TickStoreWriter writer_;
+    
+    // Double buffer: producers fill pending_, the writer thread drains writing_
+    std::vector<PendingTick> pending_;
+    std::vector<PendingTick> writing_;
+    std::mutex pendingMutex_;
+    std::condition_variable pendingCondition_;
+    
+    std::thread writerThread_;
+    std::atomic<bool> running_;
+    std::atomic<size_t> ticksWritten_;
+    std::atomic<size_t> bytesWritten_;
+    std::atomic<size_t> badTimestamps_;
+    std::atomic<size_t> badSymbols_;
+    
+    void writerThreadFunction();
+};
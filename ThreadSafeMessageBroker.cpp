@@ -4,16 +4,32 @@
 #include <algorithm>
 
 ThreadSafeMessageBroker::ThreadSafeMessageBroker() 
-    : running_(false), messageCount_(0), totalLatencyMicros_(0) {
+    : queueHead_(nullptr), queueTail_(nullptr), running_(false), 
+      messagesPublished_(MetricsRegistry::instance().counter(
+          "broker_messages_published_total", "Messages enqueued by the broker")),
+      messagesDelivered_(MetricsRegistry::instance().counter(
+          "broker_messages_delivered_total", "Messages delivered to all subscribers")),
+      queueDepth_(MetricsRegistry::instance().gauge(
+          "broker_queue_depth", "Messages waiting for a worker")),
+      deliveryLatency_(MetricsRegistry::instance().histogram(
+          "broker_delivery_latency_seconds", "Enqueue to delivery-complete latency")),
+      queueLength_(0) {
 }
 
 ThreadSafeMessageBroker::~ThreadSafeMessageBroker() {
     stop();
+    drainQueue();
 }
 
 void ThreadSafeMessageBroker::subscribe(SubscriberType type, MessageCallback callback) {
     std::lock_guard<std::mutex> lock(subscriberMutex_);
-    subscribers_[type] = callback;
+    std::string labels = std::string("subscriber=\"") + subscriberTypeName(type) + "\"";
+    subscribers_[type] = Subscription{
+        callback,
+        &MetricsRegistry::instance().histogram(
+            "subscriber_callback_seconds", "Time spent in each subscriber callback", labels),
+        &MetricsRegistry::instance().counter(
+            "subscriber_errors_total", "Exceptions thrown by subscriber callbacks", labels)};
     std::cout << "Subscriber registered for type: " << static_cast<int>(type) << std::endl;
 }
 
@@ -24,10 +40,28 @@ void ThreadSafeMessageBroker::unsubscribe(SubscriberType type) {
 }
 
 void ThreadSafeMessageBroker::publishMessage(const MarketData& data) {
+    // Field-wise assignment reuses the recycled record's string buffers
+    MessageWrapper* wrapper = MessagePool::instance().acquire();
+    wrapper->data.symbol.assign(data.symbol);
+    wrapper->data.price = data.price;
+    wrapper->data.size = data.size;
+    wrapper->data.timestamp.assign(data.timestamp);
+    wrapper->data.side = data.side;
+    wrapper->data.action = data.action;
+    wrapper->timestamp = std::chrono::steady_clock::now();
+    wrapper->next = nullptr;
+    
     {
         std::lock_guard<std::mutex> lock(queueMutex_);
-        messageQueue_.emplace(data);
+        if (queueTail_) {
+            queueTail_->next = wrapper;
+        } else {
+            queueHead_ = wrapper;
+        }
+        queueTail_ = wrapper;
+        queueDepth_.set(++queueLength_);
     }
+    messagesPublished_.inc();
     queueCondition_.notify_one();
 }
 
@@ -69,55 +103,76 @@ void ThreadSafeMessageBroker::workerThread() {
         
         // Wait for messages or stop signal
         queueCondition_.wait(lock, [this] { 
-            return !messageQueue_.empty() || !running_; 
+            return queueHead_ != nullptr || !running_; 
         });
         
         if (!running_) break;
         
-        if (!messageQueue_.empty()) {
-            MessageWrapper wrapper = messageQueue_.front();
-            messageQueue_.pop();
+        if (queueHead_) {
+            MessageWrapper* wrapper = queueHead_;
+            queueHead_ = wrapper->next;
+            if (!queueHead_) queueTail_ = nullptr;
+            queueDepth_.set(--queueLength_);
             lock.unlock();
             
             // Process message with all subscribers
             {
                 std::lock_guard<std::mutex> subscriberLock(subscriberMutex_);
-                for (const auto& [type, callback] : subscribers_) {
+                for (const auto& [type, subscription] : subscribers_) {
+                    ScopedTimer timer(*subscription.callbackTime);
                     try {
-                        callback(wrapper.data);
+                        subscription.callback(wrapper->data);
                     } catch (const std::exception& e) {
+                        subscription.errors->inc();
                         std::cerr << "Error in subscriber callback: " << e.what() << std::endl;
                     }
                 }
             }
             
             // Update statistics
-            messageCount_++;
-            double latency = calculateLatency(wrapper);
-            totalLatencyMicros_ += static_cast<uint64_t>(latency * 1000); // Convert to microseconds
+            messagesDelivered_.inc();
+            uint64_t latency = calculateLatency(*wrapper);
+            deliveryLatency_.observe(latency);
+            
+            MessagePool::instance().release(wrapper);
             
             // Log high latency messages
-            if (latency > 1.0) { // > 1ms
-                std::cout << "High latency detected: " << latency << "ms" << std::endl;
+            if (latency > 1000000) { // > 1ms
+                std::cout << "High latency detected: " << latency / 1e6 << "ms" << std::endl;
             }
         }
     }
 }
 
-double ThreadSafeMessageBroker::calculateLatency(const MessageWrapper& wrapper) const {
-    auto now = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+void ThreadSafeMessageBroker::drainQueue() {
+    // Runs from the destructor, possibly during static destruction: no
+    // metrics updates and no thread-local pool cache
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    while (queueHead_) {
+        MessageWrapper* wrapper = queueHead_;
+        queueHead_ = wrapper->next;
+        MessagePool::instance().releaseShared(wrapper);
+    }
+    queueTail_ = nullptr;
+    queueLength_ = 0;
+}
+
+uint64_t ThreadSafeMessageBroker::calculateLatency(const MessageWrapper& wrapper) const {
+    auto now = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
         now - wrapper.timestamp
     );
-    return duration.count() / 1000.0; // Convert to milliseconds
+    return duration.count();
 }
 
 size_t ThreadSafeMessageBroker::getMessageCount() const {
-    return messageCount_;
+    return messagesDelivered_.value();
 }
 
 double ThreadSafeMessageBroker::getAverageLatency() const {
-    size_t count = messageCount_;
-    if (count == 0) return 0.0;
-    return static_cast<double>(totalLatencyMicros_) / count / 1000.0; // Convert back to milliseconds
+    return deliveryLatency_.snapshot().mean() / 1e6; // Convert to milliseconds
+}
+
+size_t ThreadSafeMessageBroker::getPoolAllocations() const {
+    return MessagePool::instance().getSlabAllocations();
 }
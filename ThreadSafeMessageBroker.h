@@ -4,7 +4,6 @@
 #include <functional>
 #include <mutex>
 #include <condition_variable>
-#include <queue>
 #include <thread>
 #include <atomic>
 #include <memory>
@@ -13,17 +12,12 @@
 
 // Include MarketData definition
 #include "FeedHandler.h"
+#include "ObjectPool.h"
+#include "Metrics.h"
 
 // Callback function type for message processing
 using MessageCallback = std::function<void(const MarketData&)>;
 
-// Subscriber types for different components
-enum class SubscriberType {
-    TRADING_ALGORITHM,
-    RISK_MANAGEMENT,
-    ANALYTICS
-};
-
 class ThreadSafeMessageBroker {
 public:
     ThreadSafeMessageBroker();
@@ -43,37 +37,61 @@ public:
     // Statistics
     size_t getMessageCount() const;
     double getAverageLatency() const;
+    size_t getPoolAllocations() const;
 
 private:
+    // Pooled message record, linked intrusively into the queue
     struct MessageWrapper {
         MarketData data;
-        std::chrono::high_resolution_clock::time_point timestamp;
+        std::chrono::steady_clock::time_point timestamp;
+        MessageWrapper* next = nullptr;
         
-        MessageWrapper(const MarketData& d) 
-            : data(d), timestamp(std::chrono::high_resolution_clock::now()) {}
+        // Records are built when a slab is created; size the strings for
+        // a feed symbol and an ISO-8601 timestamp up front so refilling a
+        // fresh record never allocates
+        MessageWrapper() {
+            data.symbol.reserve(SYMBOL_RESERVE);
+            data.timestamp.reserve(TIMESTAMP_RESERVE);
+        }
     };
     
-    // Thread-safe message queue
-    std::queue<MessageWrapper> messageQueue_;
+    static constexpr size_t SYMBOL_RESERVE = 16;
+    static constexpr size_t TIMESTAMP_RESERVE = 32;
+    
+    using MessagePool = ObjectPool<MessageWrapper>;
+    
+    // Thread-safe message queue (FIFO of pooled records, no per-node allocation)
+    MessageWrapper* queueHead_;
+    MessageWrapper* queueTail_;
     std::mutex queueMutex_;
     std::condition_variable queueCondition_;
     
     // Subscriber management
-    std::map<SubscriberType, MessageCallback> subscribers_;
+    struct Subscription {
+        MessageCallback callback;
+        Histogram* callbackTime;
+        Counter* errors;
+    };
+    std::map<SubscriberType, Subscription> subscribers_;
     std::mutex subscriberMutex_;
     
     // Worker threads
     std::vector<std::thread> workerThreads_;
     std::atomic<bool> running_;
     
-    // Statistics
-    std::atomic<size_t> messageCount_;
-    std::atomic<uint64_t> totalLatencyMicros_;
-    std::mutex statsMutex_;
+    // Statistics (registered in the metrics registry)
+    Counter& messagesPublished_;
+    Counter& messagesDelivered_;
+    Gauge& queueDepth_;
+    Histogram& deliveryLatency_;
+    size_t queueLength_; // Guarded by queueMutex_
     
     // Worker thread function
     void workerThread();
     
-    // Calculate latency
-    double calculateLatency(const MessageWrapper& wrapper) const;
+    // Return any undelivered records to the pool
+    void drainQueue();
+    
+    // Calculate latency in nanoseconds
+    uint64_t calculateLatency(const MessageWrapper& wrapper) const;
 };
@@ -0,0 +1,454 @@
+#include "TickStore.h"
+#include "Timestamp.h"
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+static const char SEGMENT_MAGIC[8] = {'T', 'I', 'C', 'K', 'S', 'E', 'G', '1'};
+static const size_t SEGMENT_HEADER_SIZE = sizeof(SEGMENT_MAGIC) + sizeof(uint32_t);
+static const size_t RAW_TICK_BYTES = 2 * sizeof(int64_t) + sizeof(int32_t);
+
+// Zigzag varint helpers
+static void putVarint(std::vector<uint8_t>& out, int64_t value) {
+    uint64_t v = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v) | 0x80);
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+static bool getVarint(const uint8_t*& p, const uint8_t* end, int64_t& value) {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            value = static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+static void putRaw(std::vector<uint8_t>& out, T value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+static int64_t dayOf(int64_t nanos) {
+    int64_t day = nanos / NANOS_PER_DAY;
+    return (nanos % NANOS_PER_DAY < 0) ? day - 1 : day;
+}
+
+std::string tickSegmentName(int64_t nanos) {
+    return formatTimestamp(dayOf(nanos) * NANOS_PER_DAY).substr(0, 10);
+}
+
+bool isValidTickSymbol(const std::string& symbol) {
+    if (symbol.empty() || symbol.size() > 64 || symbol[0] == '.') {
+        return false;
+    }
+    for (char c : symbol) {
+        bool ok = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+                  c == '.' || c == '_' || c == '-';
+        if (!ok) return false;
+    }
+    return true;
+}
+
+// Tick Store Writer Implementation
+TickStoreWriter::TickStoreWriter(const std::string& root, TickEncoding encoding)
+    : root_(root), encoding_(encoding), openSegments_(0), useClock_(0), ticksWritten_(0), bytesWritten_(0) {
+}
+
+TickStoreWriter::~TickStoreWriter() {
+    close();
+}
+
+bool TickStoreWriter::append(const std::string& symbol, const StoredTick& tick) {
+    if (!isValidTickSymbol(symbol)) {
+        return false;
+    }
+
+    int64_t day = dayOf(tick.nanos);
+    Segment* segment = nullptr;
+    auto symbolIt = segments_.find(symbol);
+    if (symbolIt != segments_.end()) {
+        auto dayIt = symbolIt->second.find(day);
+        if (dayIt != symbolIt->second.end()) {
+            segment = &dayIt->second;
+        }
+    }
+    if (!segment) {
+        segment = openDaySegment(symbol, day);
+        if (!segment) return false;
+    }
+
+    segment->lastUsed = ++useClock_;
+    segment->pending.push_back(tick);
+    if (segment->pending.size() >= BLOCK_TICKS) {
+        writeBlock(*segment);
+    }
+    return true;
+}
+
+TickStoreWriter::Segment* TickStoreWriter::openDaySegment(const std::string& symbol, int64_t day) {
+    if (openSegments_ >= MAX_OPEN_SEGMENTS) {
+        evictIdleSegment();
+    }
+
+    // Days more than one behind are done; the previous day stays open for
+    // stragglers around midnight (later ones reopen its file for append)
+    auto& days = segments_[symbol];
+    for (auto it = days.begin(); it != days.end() && it->first < day - 1;) {
+        closeSegment(it->second);
+        it = days.erase(it);
+        openSegments_--;
+    }
+
+    auto it = days.emplace(day, Segment()).first;
+    if (!openSegment(symbol, day, it->second)) {
+        days.erase(it);
+        if (days.empty()) segments_.erase(symbol);
+        return nullptr;
+    }
+    openSegments_++;
+    return &it->second;
+}
+
+void TickStoreWriter::flush() {
+    for (auto& [symbol, days] : segments_) {
+        for (auto& [day, segment] : days) {
+            if (segment.data.is_open()) {
+                writeBlock(segment);
+                segment.data.flush();
+                segment.index.flush();
+            }
+        }
+    }
+}
+
+void TickStoreWriter::close() {
+    flush();
+    segments_.clear();
+    openSegments_ = 0;
+}
+
+void TickStoreWriter::closeSegment(Segment& segment) {
+    writeBlock(segment);
+    segment.data.close();
+    segment.index.close();
+}
+
+void TickStoreWriter::evictIdleSegment() {
+    // Linear scan, but only when a new segment opens with the table full
+    auto victimSymbol = segments_.end();
+    std::map<int64_t, Segment>::iterator victim;
+    for (auto symbolIt = segments_.begin(); symbolIt != segments_.end(); ++symbolIt) {
+        for (auto it = symbolIt->second.begin(); it != symbolIt->second.end(); ++it) {
+            if (victimSymbol == segments_.end() || it->second.lastUsed < victim->second.lastUsed) {
+                victimSymbol = symbolIt;
+                victim = it;
+            }
+        }
+    }
+    if (victimSymbol != segments_.end()) {
+        closeSegment(victim->second);
+        victimSymbol->second.erase(victim);
+        if (victimSymbol->second.empty()) segments_.erase(victimSymbol);
+        openSegments_--;
+    }
+}
+
+size_t TickStoreWriter::getOpenSegments() const {
+    return openSegments_;
+}
+
+size_t TickStoreWriter::getTicksWritten() const {
+    return ticksWritten_;
+}
+
+size_t TickStoreWriter::getBytesWritten() const {
+    return bytesWritten_;
+}
+
+bool TickStoreWriter::openSegment(const std::string& symbol, int64_t day, Segment& segment) {
+    std::error_code ec;
+    fs::path dir = fs::path(root_) / symbol;
+    fs::create_directories(dir, ec);
+
+    std::string name = tickSegmentName(day * NANOS_PER_DAY);
+    fs::path dataPath = dir / (name + ".ticks");
+    fs::path indexPath = dir / (name + ".idx");
+
+    uint64_t existing = fs::exists(dataPath, ec) ? fs::file_size(dataPath, ec) : 0;
+
+    segment.data.open(dataPath, std::ios::binary | std::ios::app);
+    segment.index.open(indexPath, std::ios::binary | std::ios::app);
+    if (!segment.data || !segment.index) {
+        std::cerr << "Failed to open tick segment: " << dataPath << std::endl;
+        segment.data.close();
+        segment.index.close();
+        return false;
+    }
+
+    if (existing == 0) {
+        segment.data.write(SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+        segment.data.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+        existing = SEGMENT_HEADER_SIZE;
+    }
+
+    segment.day = day;
+    segment.offset = existing;
+    segment.pending.reserve(BLOCK_TICKS);
+    return true;
+}
+
+void TickStoreWriter::writeBlock(Segment& segment) {
+    if (segment.pending.empty()) return;
+
+    const auto& ticks = segment.pending;
+    payload_.clear();
+
+    TickBlockHeader header{};
+    header.count = static_cast<uint32_t>(ticks.size());
+    header.encoding = static_cast<uint8_t>(encoding_);
+    header.firstNanos = ticks.front().nanos;
+    header.firstPriceTicks = std::llround(ticks.front().price * PRICE_SCALE);
+
+    TickIndexEntry entry{};
+    entry.minNanos = ticks.front().nanos;
+    entry.maxNanos = ticks.front().nanos;
+    entry.offset = segment.offset;
+    entry.count = header.count;
+
+    for (const auto& tick : ticks) {
+        entry.minNanos = std::min(entry.minNanos, tick.nanos);
+        entry.maxNanos = std::max(entry.maxNanos, tick.nanos);
+    }
+
+    if (encoding_ == TickEncoding::DELTA_VARINT) {
+        int64_t prev = header.firstNanos;
+        for (const auto& tick : ticks) {
+            putVarint(payload_, tick.nanos - prev);
+            prev = tick.nanos;
+        }
+        prev = header.firstPriceTicks;
+        for (const auto& tick : ticks) {
+            int64_t priceTicks = std::llround(tick.price * PRICE_SCALE);
+            putVarint(payload_, priceTicks - prev);
+            prev = priceTicks;
+        }
+        for (const auto& tick : ticks) {
+            putVarint(payload_, tick.size);
+        }
+    } else {
+        for (const auto& tick : ticks) putRaw<int64_t>(payload_, tick.nanos);
+        for (const auto& tick : ticks) putRaw<int64_t>(payload_, std::llround(tick.price * PRICE_SCALE));
+        for (const auto& tick : ticks) putRaw<int32_t>(payload_, tick.size);
+    }
+    header.payloadBytes = static_cast<uint32_t>(payload_.size());
+
+    // Block first, then its index entry, so the index never points past data
+    segment.data.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    segment.data.write(reinterpret_cast<const char*>(payload_.data()), payload_.size());
+    segment.index.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+
+    size_t blockBytes = sizeof(header) + payload_.size();
+    segment.offset += blockBytes;
+    bytesWritten_ += blockBytes + sizeof(entry);
+    ticksWritten_ += ticks.size();
+    segment.pending.clear();
+}
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) : data_(nullptr), size_(0) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                data_ = static_cast<const uint8_t*>(addr);
+                size_ = st.st_size;
+            }
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (data_) munmap(const_cast<uint8_t*>(data_), size_);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+};
+
+// Tick Store Reader Implementation
+TickStoreReader::TickStoreReader(const std::string& root) : root_(root) {}
+
+size_t TickStoreReader::query(const std::string& symbol, int64_t fromNanos, int64_t toNanos,
+                              const TickCallback& callback) const {
+    if (!isValidTickSymbol(symbol)) return 0;
+
+    std::error_code ec;
+    fs::path dir = fs::path(root_) / symbol;
+    if (!fs::is_directory(dir, ec)) return 0;
+
+    // Segment names sort chronologically; skip days outside the range
+    std::string firstDay = tickSegmentName(fromNanos);
+    std::string lastDay = tickSegmentName(toNanos - 1);
+
+    std::vector<std::string> days;
+    for (const auto& file : fs::directory_iterator(dir, ec)) {
+        if (file.path().extension() != ".ticks") continue;
+        std::string day = file.path().stem().string();
+        if (day >= firstDay && day <= lastDay) {
+            days.push_back(day);
+        }
+    }
+    std::sort(days.begin(), days.end());
+
+    size_t visited = 0;
+    for (const auto& day : days) {
+        visited += querySegment((dir / (day + ".ticks")).string(), (dir / (day + ".idx")).string(),
+                                fromNanos, toNanos, callback);
+    }
+    return visited;
+}
+
+size_t TickStoreReader::query(const std::string& symbol, int64_t fromNanos, int64_t toNanos,
+                              std::vector<StoredTick>& ticks) const {
+    return query(symbol, fromNanos, toNanos, [&ticks](const StoredTick& tick) {
+        ticks.push_back(tick);
+    });
+}
+
+std::vector<std::string> TickStoreReader::listSymbols() const {
+    std::vector<std::string> symbols;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(root_, ec)) {
+        std::string symbol = entry.path().filename().string();
+        if (entry.is_directory(ec) && isValidTickSymbol(symbol)) {
+            symbols.push_back(symbol);
+        }
+    }
+    std::sort(symbols.begin(), symbols.end());
+    return symbols;
+}
+
+static void reportCorruptBlock(const std::string& dataPath, uint64_t offset) {
+    std::cerr << "Corrupt tick block at offset " << offset << " in " << dataPath << std::endl;
+}
+
+size_t TickStoreReader::querySegment(const std::string& dataPath, const std::string& indexPath,
+                                     int64_t fromNanos, int64_t toNanos,
+                                     const TickCallback& callback) const {
+    MappedFile data(dataPath);
+    MappedFile index(indexPath);
+    if (!data.data() || !index.data() || data.size() < SEGMENT_HEADER_SIZE ||
+        std::memcmp(data.data(), SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0) {
+        return 0;
+    }
+
+    size_t visited = 0;
+    size_t entries = index.size() / sizeof(TickIndexEntry);
+    std::vector<StoredTick> block;
+
+    for (size_t i = 0; i < entries; ++i) {
+        TickIndexEntry entry;
+        std::memcpy(&entry, index.data() + i * sizeof(entry), sizeof(entry));
+        if (entry.maxNanos < fromNanos || entry.minNanos >= toNanos) continue;
+        if (entry.offset + sizeof(TickBlockHeader) > data.size()) break;
+
+        TickBlockHeader header;
+        std::memcpy(&header, data.data() + entry.offset, sizeof(header));
+        const uint8_t* p = data.data() + entry.offset + sizeof(header);
+        const uint8_t* end = p + header.payloadBytes;
+        if (end > data.data() + data.size()) break;
+
+        // Check the count against the payload before sizing anything by it:
+        // a varint tick takes at least 3 bytes, a RAW tick exactly 20
+        uint64_t count = header.count;
+        bool ok = false;
+        if (header.encoding == static_cast<uint8_t>(TickEncoding::DELTA_VARINT)) {
+            ok = count * 3 <= header.payloadBytes;
+        } else if (header.encoding == static_cast<uint8_t>(TickEncoding::RAW)) {
+            ok = count * RAW_TICK_BYTES == header.payloadBytes;
+        }
+        if (!ok) {
+            reportCorruptBlock(dataPath, entry.offset);
+            break;
+        }
+
+        block.resize(header.count);
+        if (header.encoding == static_cast<uint8_t>(TickEncoding::DELTA_VARINT)) {
+            int64_t value = header.firstNanos;
+            for (uint32_t j = 0; j < header.count && ok; ++j) {
+                int64_t delta = 0;
+                ok = getVarint(p, end, delta);
+                value += delta;
+                block[j].nanos = value;
+            }
+            value = header.firstPriceTicks;
+            for (uint32_t j = 0; j < header.count && ok; ++j) {
+                int64_t delta = 0;
+                ok = getVarint(p, end, delta);
+                value += delta;
+                block[j].price = value / TickStoreWriter::PRICE_SCALE;
+            }
+            for (uint32_t j = 0; j < header.count && ok; ++j) {
+                int64_t size = 0;
+                ok = getVarint(p, end, size);
+                block[j].size = static_cast<int>(size);
+            }
+        } else {
+            for (uint32_t j = 0; j < header.count && ok; ++j, p += sizeof(int64_t)) {
+                std::memcpy(&block[j].nanos, p, sizeof(int64_t));
+            }
+            for (uint32_t j = 0; j < header.count && ok; ++j, p += sizeof(int64_t)) {
+                int64_t priceTicks;
+                std::memcpy(&priceTicks, p, sizeof(int64_t));
+                block[j].price = priceTicks / TickStoreWriter::PRICE_SCALE;
+            }
+            for (uint32_t j = 0; j < header.count && ok; ++j, p += sizeof(int32_t)) {
+                int32_t size;
+                std::memcpy(&size, p, sizeof(int32_t));
+                block[j].size = size;
+            }
+        }
+
+        if (!ok) {
+            reportCorruptBlock(dataPath, entry.offset);
+            break;
+        }
+
+        for (const auto& tick : block) {
+            if (tick.nanos >= fromNanos && tick.nanos < toNanos) {
+                callback(tick);
+                visited++;
+            }
+        }
+    }
+    return visited;
+}
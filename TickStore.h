@@ -0,0 +1,141 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <functional>
+#include <cstdint>
+
+// Persistent tick store.
+//
+// Ticks are kept in per-symbol, per-day segment files under a root
+// directory: <root>/<SYMBOL>/<YYYY-MM-DD>.ticks plus a sparse index
+// <YYYY-MM-DD>.idx with one entry per block.
+//
+// Segment layout (little-endian):
+//   header: "TICKSEG1" magic, uint32 version
+//   blocks: TickBlockHeader, then three columns of `count` entries:
+//           timestamps, prices, sizes
+//
+// Prices are fixed-point (1/PRICE_SCALE). With DELTA_VARINT encoding,
+// timestamps and prices are zigzag varint deltas from the previous tick
+// (the first from the block header) and sizes are zigzag varints; RAW stores
+// int64/int64/int32 columns as-is.
+
+struct StoredTick {
+    int64_t nanos;      // Tick time, nanoseconds since epoch
+    double price;
+    int size;
+};
+
+enum class TickEncoding : uint8_t {
+    RAW = 0,
+    DELTA_VARINT = 1
+};
+
+#pragma pack(push, 1)
+struct TickBlockHeader {
+    uint32_t count;
+    uint8_t encoding;
+    uint8_t reserved[3];
+    int64_t firstNanos;
+    int64_t firstPriceTicks;
+    uint32_t payloadBytes;
+};
+
+// Sparse index entry; ticks inside a block may be slightly out of order,
+// so the entry records the block's min/max time
+struct TickIndexEntry {
+    int64_t minNanos;
+    int64_t maxNanos;
+    uint64_t offset;    // Offset of the block header in the segment
+    uint32_t count;
+    uint32_t reserved;
+};
+#pragma pack(pop)
+
+// Appends ticks for many symbols, one segment per symbol/day. Every tick
+// goes to its own day's segment, including late ticks from an earlier day,
+// so readers can prune by segment name. At most MAX_OPEN_SEGMENTS segments
+// are open at a time; the least recently written one is flushed and closed
+// to make room, and reopened in append mode if it is written again.
+class TickStoreWriter {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr double PRICE_SCALE = 10000.0;
+    static constexpr size_t BLOCK_TICKS = 4096;
+    static constexpr size_t MAX_OPEN_SEGMENTS = 256;
+
+    explicit TickStoreWriter(const std::string& root, TickEncoding encoding = TickEncoding::DELTA_VARINT);
+    ~TickStoreWriter();
+
+    // False if the tick was dropped (invalid symbol or unwritable segment)
+    bool append(const std::string& symbol, const StoredTick& tick);
+
+    // Write out partially filled blocks
+    void flush();
+    void close();
+
+    size_t getTicksWritten() const;
+    size_t getBytesWritten() const;
+    size_t getOpenSegments() const;
+
+private:
+    struct Segment {
+        int64_t day = 0;
+        std::ofstream data;
+        std::ofstream index;
+        uint64_t offset = 0;
+        uint64_t lastUsed = 0;
+        std::vector<StoredTick> pending;
+    };
+
+    std::string root_;
+    TickEncoding encoding_;
+    std::map<std::string, std::map<int64_t, Segment>> segments_; // Open segments by symbol, day
+    size_t openSegments_;
+    std::vector<uint8_t> payload_; // Reused encode buffer
+    uint64_t useClock_;
+    size_t ticksWritten_;
+    size_t bytesWritten_;
+
+    Segment* openDaySegment(const std::string& symbol, int64_t day);
+    bool openSegment(const std::string& symbol, int64_t day, Segment& segment);
+    void writeBlock(Segment& segment);
+    void closeSegment(Segment& segment);
+    void evictIdleSegment();
+};
+
+// Read-only access to a tick store directory
+class TickStoreReader {
+public:
+    using TickCallback = std::function<void(const StoredTick&)>;
+
+    explicit TickStoreReader(const std::string& root);
+
+    // Visit every tick for `symbol` with fromNanos <= nanos < toNanos, in
+    // file order. Only blocks whose index range overlaps are decoded.
+    // Returns the number of ticks visited.
+    size_t query(const std::string& symbol, int64_t fromNanos, int64_t toNanos,
+                 const TickCallback& callback) const;
+
+    size_t query(const std::string& symbol, int64_t fromNanos, int64_t toNanos,
+                 std::vector<StoredTick>& ticks) const;
+
+    // Symbols with at least one segment
+    std::vector<std::string> listSymbols() const;
+
+private:
+    std::string root_;
+
+    size_t querySegment(const std::string& dataPath, const std::string& indexPath,
+                        int64_t fromNanos, int64_t toNanos, const TickCallback& callback) const;
+};
+
+// Segment file name for the UTC day containing `nanos`
+std::string tickSegmentName(int64_t nanos);
+
+// Symbols become directory names, so only [A-Za-z0-9._-] is accepted,
+// without a leading dot and at most 64 characters. Anything else (path
+// separators, "..", absolute paths) is rejected by the writer and reader.
+bool isValidTickSymbol(const std::string& symbol);
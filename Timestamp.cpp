@@ -0,0 +1,114 @@
+#include "Timestamp.h"
+#include <cstdio>
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's algorithm)
+static int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+static void civilFromDays(int64_t z, int& y, unsigned& m, unsigned& d) {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<int>(yoe + era * 400 + (m <= 2));
+}
+
+// Read exactly `count` digits starting at `pos`
+static bool readDigits(const std::string& s, size_t pos, size_t count, int& value) {
+    if (pos + count > s.size()) return false;
+    value = 0;
+    for (size_t i = pos; i < pos + count; ++i) {
+        if (s[i] < '0' || s[i] > '9') return false;
+        value = value * 10 + (s[i] - '0');
+    }
+    return true;
+}
+
+bool parseTimestamp(const std::string& timestamp, int64_t& nanos) {
+    // YYYY-MM-DDTHH:MM:SS
+    int year, month, day, hour, minute, second;
+    if (!readDigits(timestamp, 0, 4, year) || timestamp[4] != '-' ||
+        !readDigits(timestamp, 5, 2, month) || timestamp[7] != '-' ||
+        !readDigits(timestamp, 8, 2, day) || (timestamp[10] != 'T' && timestamp[10] != ' ') ||
+        !readDigits(timestamp, 11, 2, hour) || timestamp[13] != ':' ||
+        !readDigits(timestamp, 14, 2, minute) || timestamp[16] != ':' ||
+        !readDigits(timestamp, 17, 2, second)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 ||
+        hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+    
+    // Optional fraction, then optional 'Z'
+    int64_t fraction = 0;
+    size_t pos = 19;
+    if (pos < timestamp.size() && timestamp[pos] == '.') {
+        int64_t scale = NANOS_PER_SECOND;
+        ++pos;
+        while (pos < timestamp.size() && timestamp[pos] >= '0' && timestamp[pos] <= '9') {
+            if (scale > 1) {
+                scale /= 10;
+                fraction += (timestamp[pos] - '0') * scale;
+            }
+            ++pos;
+        }
+    }
+    if (pos < timestamp.size() && timestamp[pos] == 'Z') ++pos;
+    if (pos != timestamp.size()) return false;
+    
+    int64_t days = daysFromCivil(year, month, day);
+    int64_t seconds = days * 86400 + hour * 3600 + minute * 60 + second;
+    nanos = seconds * NANOS_PER_SECOND + fraction;
+    return true;
+}
+
+// Writes YYYY-MM-DDTHH:MM:SS.<fraction>Z with 3 (millisecond) or 9
+// (nanosecond) fraction digits; returns the length
+static int formatInto(char* buffer, size_t size, int64_t nanos, bool fullPrecision) {
+    int64_t days = nanos / NANOS_PER_DAY;
+    int64_t rem = nanos % NANOS_PER_DAY;
+    if (rem < 0) {
+        rem += NANOS_PER_DAY;
+        --days;
+    }
+    
+    int year;
+    unsigned month, day;
+    civilFromDays(days, year, month, day);
+    
+    int64_t secondsOfDay = rem / NANOS_PER_SECOND;
+    int fraction = static_cast<int>(rem % NANOS_PER_SECOND);
+    if (!fullPrecision) {
+        fraction /= 1000000;
+    }
+    
+    return std::snprintf(buffer, size, "%04d-%02u-%02uT%02d:%02d:%02d.%0*dZ",
+                         year, month, day,
+                         static_cast<int>(secondsOfDay / 3600),
+                         static_cast<int>(secondsOfDay / 60 % 60),
+                         static_cast<int>(secondsOfDay % 60),
+                         fullPrecision ? 9 : 3, fraction);
+}
+
+std::string formatTimestamp(int64_t nanos) {
+    char buffer[64];
+    formatInto(buffer, sizeof(buffer), nanos, false);
+    return buffer;
+}
+
+void formatTimestampNanos(int64_t nanos, std::string& out) {
+    char buffer[64];
+    int length = formatInto(buffer, sizeof(buffer), nanos, true);
+    out.assign(buffer, length);
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+// Tick-time helpers for ISO-8601 UTC timestamps as sent by the feed,
+// e.g. 2024-01-01T10:00:00.000Z (fraction optional, up to 9 digits)
+
+constexpr int64_t NANOS_PER_SECOND = 1000000000LL;
+constexpr int64_t NANOS_PER_DAY = 86400LL * NANOS_PER_SECOND;
+
+// Parse into nanoseconds since the Unix epoch; false if malformed
+bool parseTimestamp(const std::string& timestamp, int64_t& nanos);
+
+// Format nanoseconds since the Unix epoch with millisecond precision
+std::string formatTimestamp(int64_t nanos);
+
+// Format with full nanosecond precision into `out`, reusing its buffer
+void formatTimestampNanos(int64_t nanos, std::string& out);
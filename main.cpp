@@ -2,10 +2,23 @@
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <sstream>
+#include <cstdlib>
+#include <algorithm>
 #include <signal.h>
+#include <cerrno>
+#include <cstdio>
 #include "FeedHandler.h"
 #include "ThreadSafeMessageBroker.h"
 #include "Subscribers.h"
+#include "MessagePublisher.h"
+#include "AsyncPublisher.h"
+#include "Timestamp.h"
+#include "Snapshot.h"
+#include "SharedMemoryRing.h"
+#include "Metrics.h"
+#include "MetricsServer.h"
+#include "AllocationCounter.h"
 
 // Global variables for cleanup
 std::shared_ptr<FeedHandler> g_feedHandler;
@@ -13,36 +26,128 @@ std::shared_ptr<ThreadSafeMessageBroker> g_messageBroker;
 std::shared_ptr<TradingAlgorithmSubscriber> g_tradingSub;
 std::shared_ptr<RiskManagementSubscriber> g_riskSub;
 std::shared_ptr<AnalyticsSubscriber> g_analyticsSub;
+std::shared_ptr<OrderBookSubscriber> g_orderBookSub;
+std::shared_ptr<BarSubscriber> g_barSub;
+std::shared_ptr<MessagePublisher> g_barPublisher;
+std::shared_ptr<MessagePublisher> g_bookPublisher;
+std::shared_ptr<AsyncPublisher<BookSnapshot>> g_bookSnapshots;
+std::shared_ptr<AsyncPublisher<Bar>> g_barPublications;
+std::shared_ptr<TickStoreSubscriber> g_tickStoreSub;
+std::shared_ptr<SnapshotManager> g_snapshotManager;
+std::shared_ptr<SharedMemoryPublisher> g_shmPublisher;
+std::shared_ptr<MetricsServer> g_metricsServer;
 
-// Signal handler for graceful shutdown
-void signalHandler(int signal) {
+// Expose statistics that components already track as read-time metrics
+void registerComponentMetrics() {
+    auto& registry = MetricsRegistry::instance();
+    
+    registry.counterFunction("process_allocations_total", "Global operator new calls", "",
+        [] { return static_cast<double>(getGlobalAllocations()); });
+    registry.gaugeFunction("broker_pool_slab_allocations", "Slabs allocated by the message pool", "",
+        [] { return static_cast<double>(g_messageBroker->getPoolAllocations()); });
+    registry.counterFunction("analytics_messages_total", "Trades aggregated by analytics", "",
+        [] { return static_cast<double>(g_analyticsSub->getTotalMessages()); });
+    registry.counterFunction("order_book_updates_total", "Events applied to order books", "",
+        [] { return static_cast<double>(g_orderBookSub->getUpdateCount()); });
+    registry.counterFunction("bars_completed_total", "OHLCV bars closed", "",
+        [] { return static_cast<double>(g_barSub->getBarsCompleted()); });
+    registry.counterFunction("bars_bad_timestamps_total", "Trades skipped for unparseable timestamps", "",
+        [] { return static_cast<double>(g_barSub->getBadTimestamps()); });
+    registry.counterFunction("book_snapshots_dropped_total", "Book snapshots dropped because the publisher fell behind", "",
+        [] { return static_cast<double>(g_bookSnapshots->getDropped()); });
+    
+    if (g_tickStoreSub) {
+        registry.counterFunction("tick_store_ticks_written_total", "Ticks persisted to segments", "",
+            [] { return static_cast<double>(g_tickStoreSub->getTicksWritten()); });
+        registry.counterFunction("tick_store_bad_symbols_total", "Trades skipped for symbols unsafe as paths", "",
+            [] { return static_cast<double>(g_tickStoreSub->getBadSymbols()); });
+        registry.counterFunction("tick_store_bytes_written_total", "Bytes written to segments and indexes", "",
+            [] { return static_cast<double>(g_tickStoreSub->getBytesWritten()); });
+    }
+    if (g_snapshotManager) {
+        registry.counterFunction("snapshots_written_total", "Warm-start snapshots written", "",
+            [] { return static_cast<double>(g_snapshotManager->getSnapshotsWritten()); });
+    }
+    if (g_shmPublisher) {
+        registry.counterFunction("shm_ticks_published_total", "Ticks published to the shared-memory ring", "",
+            [] { return static_cast<double>(g_shmPublisher->getPublished()); });
+    }
+}
+
+// Append " size@price" per level, formatted like an ostream, into a reused line
+static void appendLevels(std::string& line, const std::vector<BookLevel>& levels) {
+    char buffer[64];
+    for (const auto& level : levels) {
+        int length = std::snprintf(buffer, sizeof(buffer), " %lld@%g",
+                                   static_cast<long long>(level.size), level.price);
+        line.append(buffer, length);
+    }
+}
+
+// Graceful shutdown, run on the main thread once a signal is received
+void shutdownGracefully(int signal) {
     std::cout << "\nReceived signal " << signal << ", shutting down gracefully..." << std::endl;
     
     if (g_feedHandler) {
         g_feedHandler->stop();
     }
     
+    if (g_metricsServer) {
+        g_metricsServer->stop();
+    }
+    
+    if (g_bookSnapshots) {
+        g_bookSnapshots->stop();
+    }
+    
     if (g_messageBroker) {
         g_messageBroker->stop();
     }
     
+    if (g_tickStoreSub) {
+        g_tickStoreSub->stop();
+    }
+    
+    // Final snapshot once no more messages are being delivered
+    if (g_snapshotManager) {
+        g_snapshotManager->stop();
+        g_snapshotManager->saveNow();
+    }
+    
+    if (g_barSub) {
+        g_barSub->flush();
+        std::cout << "Bars completed: " << g_barSub->getBarsCompleted() << std::endl;
+    }
+    
+    // After the flush, so the bars it closed are published too
+    if (g_barPublications) {
+        g_barPublications->stop();
+    }
+    
     if (g_analyticsSub) {
         g_analyticsSub->generateReports();
     }
     
+    if (g_orderBookSub) {
+        g_orderBookSub->generateReports();
+    }
+    
     std::cout << "Shutdown complete." << std::endl;
-    exit(0);
 }
 
 int main() {
-    // Set up signal handlers
-    signal(SIGINT, signalHandler);
-    signal(SIGTERM, signalHandler);
+    // Shutdown signals are blocked before any thread starts, so every worker
+    // inherits the mask and they are only ever taken by sigtimedwait below
+    sigset_t shutdownSignals;
+    sigemptyset(&shutdownSignals);
+    sigaddset(&shutdownSignals, SIGINT);
+    sigaddset(&shutdownSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &shutdownSignals, nullptr);
     
     std::cout << "=== Market Data Feed Handler ===" << std::endl;
     std::cout << "Features:" << std::endl;
     std::cout << "- Thread-safe message distribution" << std::endl;
-    std::cout << "- Multiple subscribers (Trading, Risk, Analytics)" << std::endl;
+    std::cout << "- Multiple subscribers (Trading, Risk, Analytics, Order Book, Bars)" << std::endl;
     std::cout << "- Sub-millisecond latency processing" << std::endl;
     std::cout << "- Async processing queues" << std::endl;
     std::cout << "- Callback-based subscriptions" << std::endl;
@@ -58,6 +163,11 @@ int main() {
         g_tradingSub = std::make_shared<TradingAlgorithmSubscriber>();
         g_riskSub = std::make_shared<RiskManagementSubscriber>();
         g_analyticsSub = std::make_shared<AnalyticsSubscriber>();
+        const size_t bookDepth = 5;
+        g_orderBookSub = std::make_shared<OrderBookSubscriber>(bookDepth);
+        g_barSub = std::make_shared<BarSubscriber>(std::vector<int64_t>{1, 60, 300});
+        g_barPublisher = std::make_shared<MessagePublisher>();
+        g_bookPublisher = std::make_shared<MessagePublisher>();
         
         // Subscribe to message broker
         g_messageBroker->subscribe(SubscriberType::TRADING_ALGORITHM, 
@@ -69,6 +179,120 @@ int main() {
         g_messageBroker->subscribe(SubscriberType::ANALYTICS, 
             [&](const MarketData& data) { g_analyticsSub->onMarketData(data); });
         
+        // Publish minute and five-minute bars downstream. Bars are built on
+        // the network thread (see below), so output goes through a publisher
+        // thread like book snapshots
+        g_barPublications = std::make_shared<AsyncPublisher<Bar>>(256,
+            [](const Bar& bar) {
+                std::ostringstream ss;
+                ss << "BAR " << bar.symbol << " " << bar.intervalNanos / NANOS_PER_SECOND << "s "
+                   << formatTimestamp(bar.startNanos)
+                   << " O=" << bar.open << " H=" << bar.high << " L=" << bar.low << " C=" << bar.close
+                   << " V=" << bar.volume << " VWAP=" << bar.vwap();
+                g_barPublisher->publish(ss.str());
+            },
+            [](Bar& slot) { slot.symbol.reserve(16); });
+        g_barPublications->start();
+        g_barSub->addBarCallback([&](const Bar& bar) {
+            if (bar.intervalNanos < 60 * NANOS_PER_SECOND) return;
+            g_barPublications->push(bar);
+        });
+        
+        // Publish top-of-book depth whenever the visible levels change. The
+        // book runs on the network thread, so it only copies each snapshot
+        // into the queue; formatting and output happen on the publisher
+        // thread, into a reused line
+        g_bookSnapshots = std::make_shared<AsyncPublisher<BookSnapshot>>(1024,
+            [line = std::string()](const BookSnapshot& snapshot) mutable {
+                line.assign("BOOK ").append(snapshot.symbol).append(" ")
+                    .append(snapshot.timestamp).append(" BIDS");
+                appendLevels(line, snapshot.bids);
+                line.append(" ASKS");
+                appendLevels(line, snapshot.asks);
+                g_bookPublisher->publish(line);
+            },
+            [bookDepth](BookSnapshot& slot) {
+                slot.symbol.reserve(16);
+                slot.timestamp.reserve(32);
+                slot.bids.reserve(bookDepth);
+                slot.asks.reserve(bookDepth);
+            });
+        g_bookSnapshots->start();
+        g_orderBookSub->setSnapshotCallback([&](const BookSnapshot& snapshot) {
+            g_bookSnapshots->push(snapshot);
+        });
+        
+        // Optional columnar bar file for research
+        if (const char* barFile = std::getenv("FEEDHANDLER_BAR_FILE")) {
+            g_barSub->enableBarFile(barFile);
+        }
+        
+        // Optional shared-memory publication to out-of-process consumers
+        if (const char* shmName = std::getenv("FEEDHANDLER_SHM_NAME")) {
+            g_shmPublisher = std::make_shared<SharedMemoryPublisher>();
+            if (!g_shmPublisher->open(shmName)) {
+                g_shmPublisher.reset();
+            }
+        }
+        
+        // Optional warm start: restore subscriber state from the last snapshot
+        if (const char* snapshotFile = std::getenv("FEEDHANDLER_SNAPSHOT_FILE")) {
+            g_snapshotManager = std::make_shared<SnapshotManager>(snapshotFile);
+            g_snapshotManager->registerSection(SubscriberType::TRADING_ALGORITHM,
+                [&](SnapshotWriter& writer) { g_tradingSub->saveState(writer); },
+                [&](SnapshotReader& reader) { return g_tradingSub->loadState(reader); });
+            g_snapshotManager->registerSection(SubscriberType::RISK_MANAGEMENT,
+                [&](SnapshotWriter& writer) { g_riskSub->saveState(writer); },
+                [&](SnapshotReader& reader) { return g_riskSub->loadState(reader); });
+            g_snapshotManager->registerSection(SubscriberType::ANALYTICS,
+                [&](SnapshotWriter& writer) { g_analyticsSub->saveState(writer); },
+                [&](SnapshotReader& reader) { return g_analyticsSub->loadState(reader); });
+            
+            auto restoreStart = std::chrono::high_resolution_clock::now();
+            if (g_snapshotManager->restore()) {
+                auto restoreTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::high_resolution_clock::now() - restoreStart);
+                std::cout << "Restored snapshot from " << formatTimestamp(g_snapshotManager->getSnapshotTime()) 
+                          << " in " << restoreTime.count() << " us" << std::endl;
+            }
+            g_snapshotManager->start();
+        }
+        
+        // Optional tick persistence; today's stored ticks backfill analytics.
+        // After a warm start each symbol resumes strictly after the latest
+        // tick time already in its restored aggregates (tick time, not the
+        // snapshot's wall-clock time, so nothing is counted twice). Replayed
+        // ticks keep their stored nanosecond times
+        if (const char* tickDir = std::getenv("FEEDHANDLER_TICK_DIR")) {
+            auto backfillStart = std::chrono::high_resolution_clock::now();
+            int64_t nowNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            int64_t dayStart = nowNanos - nowNanos % NANOS_PER_DAY;
+            
+            TickStoreReader reader(tickDir);
+            size_t backfilled = 0;
+            MarketData replay;
+            for (const auto& symbol : reader.listSymbols()) {
+                int64_t from = std::max(dayStart, g_analyticsSub->getLastTickTime(symbol) + 1);
+                replay.symbol = symbol;
+                backfilled += reader.query(symbol, from, nowNanos + 1, [&](const StoredTick& tick) {
+                    replay.price = tick.price;
+                    replay.size = tick.size;
+                    g_analyticsSub->onTrade(replay, tick.nanos);
+                });
+            }
+            
+            auto backfillTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - backfillStart);
+            std::cout << "Backfilled " << backfilled << " ticks into analytics in " 
+                      << backfillTime.count() << " ms" << std::endl;
+            
+            g_tickStoreSub = std::make_shared<TickStoreSubscriber>(tickDir);
+            g_tickStoreSub->start();
+            g_messageBroker->subscribe(SubscriberType::TICK_STORE, 
+                [&](const MarketData& data) { g_tickStoreSub->onMarketData(data); });
+        }
+        
         // Configure trading algorithm
         g_tradingSub->addSymbol("AAPL");
         g_tradingSub->addSymbol("GOOGL");
@@ -85,50 +309,86 @@ int main() {
         g_feedHandler = std::make_shared<FeedHandler>("127.0.0.1", 9000);
         g_feedHandler->setMessageBroker(g_messageBroker);
         
+        // The shared-memory ring is written from the network thread only,
+        // in feed order and ahead of everything else
+        if (g_shmPublisher) {
+            g_feedHandler->addOrderedSubscriber(SubscriberType::SHARED_MEMORY,
+                [&](const MarketData& data) { g_shmPublisher->publish(data); });
+        }
+        
+        // Book events must be applied in feed order, which the broker's
+        // worker pool does not guarantee
+        g_feedHandler->addOrderedSubscriber(SubscriberType::ORDER_BOOK,
+            [&](const MarketData& data) { g_orderBookSub->onMarketData(data); });
+        
+        // Likewise bars: a reordered tick from the next bucket would close a
+        // bar early and fold the earlier tick into the new bar
+        g_feedHandler->addOrderedSubscriber(SubscriberType::BARS,
+            [&](const MarketData& data) { g_barSub->onMarketData(data); });
+        
         // Start feed handler
         g_feedHandler->start();
         
         std::cout << "System started successfully!" << std::endl;
         std::cout << "Press Ctrl+C to stop and generate reports." << std::endl;
         
-        // Main loop - monitor performance
-        auto startTime = std::chrono::high_resolution_clock::now();
+        // Metrics endpoint (Prometheus text on /metrics)
+        int metricsPort = 9100;
+        if (const char* port = std::getenv("FEEDHANDLER_METRICS_PORT")) {
+            metricsPort = std::atoi(port);
+        }
+        registerComponentMetrics();
+        g_metricsServer = std::make_shared<MetricsServer>("127.0.0.1", metricsPort);
+        g_metricsServer->start();
+        
+        // Main loop - console summary from the metrics registry every 5s
+        // until a shutdown signal arrives; rates use the measured interval
+        auto& registry = MetricsRegistry::instance();
+        Histogram& deliveryLatency = registry.histogram(
+            "broker_delivery_latency_seconds", "Enqueue to delivery-complete latency");
+        Gauge& queueDepth = registry.gauge("broker_queue_depth", "Messages waiting for a worker");
+        Counter& parseErrors = registry.counter(
+            "feedhandler_parse_errors_total", "Messages rejected by the parser");
+        
+        auto lastTime = std::chrono::steady_clock::now();
         size_t lastMessageCount = 0;
+        uint64_t lastAllocations = getGlobalAllocations();
         
+        const timespec statsInterval{5, 0};
         while (true) {
-            std::this_thread::sleep_for(std::chrono::seconds(5));
+            int signal = sigtimedwait(&shutdownSignals, nullptr, &statsInterval);
+            if (signal > 0) {
+                shutdownGracefully(signal);
+                break;
+            }
+            if (errno != EAGAIN) continue; // EINTR
             
-            // Performance monitoring
+            auto now = std::chrono::steady_clock::now();
+            double elapsed = std::chrono::duration<double>(now - lastTime).count();
             size_t currentMessages = g_feedHandler->getMessagesProcessed();
-            size_t brokerMessages = g_messageBroker->getMessageCount();
-            double avgLatency = g_messageBroker->getAverageLatency();
-            double avgProcessingTime = g_feedHandler->getAverageProcessingTime();
-            
-            auto now = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::seconds>(now - startTime);
+            Histogram::Snapshot latency = deliveryLatency.snapshot();
             
-            size_t messagesPerSecond = (currentMessages - lastMessageCount) / 5;
+            uint64_t currentAllocations = getGlobalAllocations();
             
-            std::cout << "\n=== PERFORMANCE STATS ===" << std::endl;
-            std::cout << "Runtime: " << duration.count() << " seconds" << std::endl;
-            std::cout << "Messages Processed: " << currentMessages << std::endl;
-            std::cout << "Messages Published: " << brokerMessages << std::endl;
-            std::cout << "Current Rate: " << messagesPerSecond << " msg/sec" << std::endl;
-            std::cout << "Average Latency: " << avgLatency << " ms" << std::endl;
-            std::cout << "Average Processing Time: " << avgProcessingTime << " ms" << std::endl;
-            std::cout << "========================\n" << std::endl;
+            double messagesPerSecond = (currentMessages - lastMessageCount) / elapsed;
             
-            lastMessageCount = currentMessages;
+            // Zero once the message pool has grown to the peak backlog
+            double allocationsPerMessage = currentMessages > lastMessageCount
+                ? static_cast<double>(currentAllocations - lastAllocations) / (currentMessages - lastMessageCount)
+                : 0.0;
             
-            // Check for high throughput
-            if (messagesPerSecond > 10000) {
-                std::cout << "HIGH THROUGHPUT ACHIEVED: " << messagesPerSecond << " msg/sec!" << std::endl;
-            }
+            std::cout << "STATS rate=" << static_cast<size_t>(messagesPerSecond) << " msg/s"
+                      << " processed=" << currentMessages
+                      << " delivered=" << g_messageBroker->getMessageCount()
+                      << " queue=" << queueDepth.value()
+                      << " parse_errors=" << parseErrors.value()
+                      << " latency_mean=" << latency.mean() / 1e3 << "us"
+                      << " p99<=" << latency.quantile(0.99) / 1e3 << "us"
+                      << " allocs/msg=" << allocationsPerMessage << std::endl;
             
-            // Check for sub-millisecond latency
-            if (avgLatency < 1.0 && avgLatency > 0) {
-                std::cout << "SUB-MILLISECOND LATENCY ACHIEVED: " << avgLatency << " ms!" << std::endl;
-            }
+            lastTime = now;
+            lastMessageCount = currentMessages;
+            lastAllocations = currentAllocations;
         }
         
     } catch (const std::exception& e) {
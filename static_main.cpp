@@ -0,0 +1,182 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include "Pipeline.h"
+#include "FeedHandler.h"
+#include "ThreadSafeMessageBroker.h"
+#include "Subscribers.h"
+
+// Replays a captured feed through the compile-time pipeline and through the
+// dynamic broker, using the same parser and subscribers, and compares
+// throughput:
+//
+//   ./feedhandler_static ticks.csv [passes]
+//
+// Capture a replay file with:
+//   python3 tools/generator.py --burst 1000000 --output ticks.csv
+
+using StaticPipeline = Pipeline<CsvParser,
+                                TradingAlgorithmSubscriber,
+                                RiskManagementSubscriber,
+                                AnalyticsSubscriber,
+                                OrderBookSubscriber,
+                                BarSubscriber>;
+
+// Same symbols main.cpp trades
+static const char* TRADED_SYMBOLS[] = {"AAPL", "GOOGL", "MSFT"};
+
+struct ReplayResult {
+    size_t messages = 0;
+    double seconds = 0.0;
+    size_t analyticsMessages = 0;
+    size_t bookUpdates = 0;
+
+    double nanosPerMessage() const { return messages ? seconds * 1e9 / messages : 0.0; }
+    double messagesPerSecond() const { return seconds > 0 ? messages / seconds : 0.0; }
+};
+
+static bool loadReplay(const std::string& path, std::vector<std::string>& lines) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Failed to open replay file: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) lines.push_back(line);
+    }
+    return true;
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static ReplayResult replayStatic(const std::vector<std::string>& lines, int passes) {
+    StaticPipeline pipeline;
+    for (const char* symbol : TRADED_SYMBOLS) {
+        pipeline.get<TradingAlgorithmSubscriber>().addSymbol(symbol);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const auto& line : lines) {
+            pipeline.processLine(line);
+        }
+    }
+
+    ReplayResult result;
+    result.seconds = secondsSince(start);
+    result.messages = pipeline.getMessagesProcessed();
+    result.analyticsMessages = pipeline.get<AnalyticsSubscriber>().getTotalMessages();
+    result.bookUpdates = pipeline.get<OrderBookSubscriber>().getUpdateCount();
+    return result;
+}
+
+static ReplayResult replayDynamic(const std::vector<std::string>& lines, int passes) {
+    // Wired exactly like main.cpp: FeedHandler -> broker -> std::function
+    // callbacks, with the order book and bars applied on the feed thread
+    auto broker = std::make_shared<ThreadSafeMessageBroker>();
+    auto tradingSub = std::make_shared<TradingAlgorithmSubscriber>();
+    auto riskSub = std::make_shared<RiskManagementSubscriber>();
+    auto analyticsSub = std::make_shared<AnalyticsSubscriber>();
+    auto orderBookSub = std::make_shared<OrderBookSubscriber>();
+    auto barSub = std::make_shared<BarSubscriber>();
+
+    broker->subscribe(SubscriberType::TRADING_ALGORITHM,
+        [tradingSub](const MarketData& data) { tradingSub->onMarketData(data); });
+    broker->subscribe(SubscriberType::RISK_MANAGEMENT,
+        [riskSub](const MarketData& data) { riskSub->onMarketData(data); });
+    broker->subscribe(SubscriberType::ANALYTICS,
+        [analyticsSub](const MarketData& data) { analyticsSub->onMarketData(data); });
+
+    for (const char* symbol : TRADED_SYMBOLS) {
+        tradingSub->addSymbol(symbol);
+    }
+
+    FeedHandler feedHandler("127.0.0.1", 0); // Never started; fed directly
+    feedHandler.setMessageBroker(broker);
+    feedHandler.addOrderedSubscriber(SubscriberType::ORDER_BOOK,
+        [orderBookSub](const MarketData& data) { orderBookSub->onMarketData(data); });
+    feedHandler.addOrderedSubscriber(SubscriberType::BARS,
+        [barSub](const MarketData& data) { barSub->onMarketData(data); });
+    broker->start();
+
+    // Registry counters are process-wide, so measure deltas
+    size_t processedBefore = feedHandler.getMessagesProcessed();
+    size_t deliveredBefore = broker->getMessageCount();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const auto& line : lines) {
+            feedHandler.processMessage(line);
+        }
+    }
+
+    // Done once every published message has been through all subscribers
+    size_t published = feedHandler.getMessagesProcessed() - processedBefore;
+    while (broker->getMessageCount() - deliveredBefore < published) {
+        std::this_thread::yield();
+    }
+
+    ReplayResult result;
+    result.seconds = secondsSince(start);
+    result.messages = published;
+    result.analyticsMessages = analyticsSub->getTotalMessages();
+    result.bookUpdates = orderBookSub->getUpdateCount();
+
+    broker->stop();
+    return result;
+}
+
+static void printResult(const char* name, const ReplayResult& result) {
+    std::cout << name << ": " << result.messages << " msgs in " << result.seconds << "s, "
+              << static_cast<size_t>(result.messagesPerSecond()) << " msg/s, "
+              << result.nanosPerMessage() << " ns/msg" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <replay-file> [passes]" << std::endl;
+        return 1;
+    }
+
+    int passes = argc > 2 ? std::atoi(argv[2]) : 1;
+    if (passes <= 0) {
+        std::cerr << "passes must be positive" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> lines;
+    if (!loadReplay(argv[1], lines)) {
+        return 1;
+    }
+    std::cout << "Replaying " << lines.size() << " messages x " << passes << " passes" << std::endl;
+
+    ReplayResult staticResult = replayStatic(lines, passes);
+    ReplayResult dynamicResult = replayDynamic(lines, passes);
+
+    std::cout << "\n=== REPLAY COMPARISON ===" << std::endl;
+    printResult("Static pipeline", staticResult);
+    printResult("Dynamic broker ", dynamicResult);
+    if (staticResult.seconds > 0) {
+        std::cout << "Speedup: " << dynamicResult.seconds / staticResult.seconds << "x" << std::endl;
+    }
+
+    // Both paths must have done the same work
+    if (staticResult.messages != dynamicResult.messages ||
+        staticResult.analyticsMessages != dynamicResult.analyticsMessages ||
+        staticResult.bookUpdates != dynamicResult.bookUpdates) {
+        std::cerr << "Mismatch between static and dynamic results" << std::endl;
+        return 1;
+    }
+    std::cout << "=========================" << std::endl;
+    return 0;
+}
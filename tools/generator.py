@@ -13,9 +13,10 @@ from datetime import datetime
 
 
 class MarketDataGenerator:
-    def __init__(self, host: str = "127.0.0.1", port: int = 9000):
+    def __init__(self, host: str = "127.0.0.1", port: int = 9000, book: bool = False):
         self.host = host
         self.port = port
+        self.book = book
         self.socket = None
         self.sequence_number = 0
         self.symbols = ["AAPL", "GOOGL", "MSFT", "TSLA", "AMZN", "META", "NVDA", "NFLX"]
@@ -70,6 +71,26 @@ class MarketDataGenerator:
 
         return message
 
+    def generate_book_event(self) -> str:
+        """Generate a single order book event (add/modify/delete/trade)."""
+        symbol = random.choice(self.symbols)
+        base_price = self.base_prices[symbol]
+
+        # Levels sit on a 1-cent grid within 1% of the base price
+        side = random.choice(["B", "S"])
+        offset = random.randint(1, max(1, int(base_price)))
+        price = base_price - offset * 0.01 if side == "B" else base_price + offset * 0.01
+
+        action = random.choices(["A", "M", "D", "T"], weights=[50, 25, 15, 10])[0]
+        volume = random.randint(100, 5000)
+        timestamp = datetime.now().strftime("%Y-%m-%dT%H:%M:%S.%fZ")
+
+        # Format: symbol,price,volume,timestamp,side,action
+        return f"{symbol},{price:.2f},{volume},{timestamp},{side},{action}\n"
+
+    def next_message(self) -> str:
+        return self.generate_book_event() if self.book else self.generate_market_data()
+
     def send_message(self, message: str) -> bool:
         """Send a message to the server."""
         try:
@@ -98,7 +119,7 @@ class MarketDataGenerator:
 
         try:
             while True:
-                message = self.generate_market_data()
+                message = self.next_message()
 
                 if not self.send_message(message):
                     print("Connection lost, attempting to reconnect...")
@@ -150,7 +171,7 @@ class MarketDataGenerator:
 
         try:
             for i in range(total_messages):
-                message = self.generate_market_data()
+                message = self.next_message()
 
                 if not self.send_message(message):
                     print(f"Failed to send message {i + 1}")
@@ -173,6 +194,13 @@ class MarketDataGenerator:
             print(f"Rate: {actual_rate:.1f} msg/sec")
             self.disconnect()
 
+    def write_file(self, path: str, total_messages: int):
+        """Write N messages to a file for offline replay instead of sending them."""
+        with open(path, "w") as out:
+            for _ in range(total_messages):
+                out.write(self.next_message())
+        print(f"Wrote {total_messages} messages to {path}")
+
 
 def main():
     parser = argparse.ArgumentParser(description="Market Data Generator")
@@ -194,12 +222,26 @@ def main():
     parser.add_argument(
         "--burst-rate", type=int, default=10000, help="Burst rate (default: 10000)"
     )
+    parser.add_argument(
+        "--book",
+        action="store_true",
+        help="Send order book events (symbol,price,size,timestamp,side,action)",
+    )
+
+    parser.add_argument(
+        "--output",
+        help="Write the --burst messages to this file instead of sending them",
+    )
 
     args = parser.parse_args()
 
-    generator = MarketDataGenerator(args.host, args.port)
+    generator = MarketDataGenerator(args.host, args.port, args.book)
 
-    if args.burst:
+    if args.output:
+        if not args.burst:
+            parser.error("--output requires --burst")
+        generator.write_file(args.output, args.burst)
+    elif args.burst:
         generator.run_burst(args.burst, args.burst_rate)
     else:
         generator.run_continuous(args.rate, args.duration)
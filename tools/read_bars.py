@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""
+Bar File Reader
+Reads the columnar OHLCV bar files written by the feed handler
+(FEEDHANDLER_BAR_FILE) and prints them as CSV.
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"OHLCVBAR"
+
+# (name, struct format) in on-disk column order
+COLUMNS = [
+    ("symbol_index", "H"),
+    ("start_nanos", "q"),
+    ("interval_nanos", "q"),
+    ("open", "d"),
+    ("high", "d"),
+    ("low", "d"),
+    ("close", "d"),
+    ("volume", "q"),
+    ("vwap", "d"),
+    ("trade_count", "I"),
+]
+
+
+def read_bars(path: str):
+    """Yield one dict per bar."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if data[:8] != MAGIC:
+        raise ValueError(f"{path}: not a bar file")
+    (version,) = struct.unpack_from("<I", data, 8)
+    if version != 1:
+        raise ValueError(f"{path}: unsupported version {version}")
+
+    offset = 12
+    while offset < len(data):
+        rows, symbol_count = struct.unpack_from("<IH", data, offset)
+        offset += 6
+
+        symbols = []
+        for _ in range(symbol_count):
+            (length,) = struct.unpack_from("<B", data, offset)
+            offset += 1
+            symbols.append(data[offset : offset + length].decode("utf-8"))
+            offset += length
+
+        columns = {}
+        for name, fmt in COLUMNS:
+            columns[name] = struct.unpack_from(f"<{rows}{fmt}", data, offset)
+            offset += rows * struct.calcsize(fmt)
+
+        for i in range(rows):
+            bar = {name: columns[name][i] for name, _ in COLUMNS}
+            bar["symbol"] = symbols[bar.pop("symbol_index")]
+            yield bar
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Bar File Reader")
+    parser.add_argument("path", help="Bar file written by the feed handler")
+    parser.add_argument("--symbol", help="Only print bars for this symbol")
+    parser.add_argument(
+        "--interval", type=int, help="Only print bars of this interval (seconds)"
+    )
+    args = parser.parse_args()
+
+    fields = ["symbol", "interval", "start_nanos", "open", "high", "low", "close",
+              "volume", "vwap", "trade_count"]
+    print(",".join(fields))
+
+    for bar in read_bars(args.path):
+        bar["interval"] = bar["interval_nanos"] // 1_000_000_000
+        if args.symbol and bar["symbol"] != args.symbol:
+            continue
+        if args.interval and bar["interval"] != args.interval:
+            continue
+        print(",".join(str(bar[field]) for field in fields))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,59 @@
+// Example out-of-process consumer of the feed handler's shared-memory ring.
+//
+// Build with `make shm_reader`, start the feed handler with
+// FEEDHANDLER_SHM_NAME=/feedhandler_ticks, then run:
+//   ./shm_reader /feedhandler_ticks
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <signal.h>
+#include "../SharedMemoryRing.h"
+
+static volatile sig_atomic_t g_running = 1;
+
+static void signalHandler(int) {
+    g_running = 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::string name = argc > 1 ? argv[1] : "/feedhandler_ticks";
+    bool quiet = argc > 2 && std::string(argv[2]) == "--quiet";
+    
+    signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
+    
+    SharedMemoryReader reader;
+    while (g_running && !reader.open(name)) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    
+    std::cout << "Attached to " << name << std::endl;
+    
+    MarketData data;
+    uint64_t received = 0;
+    uint64_t overruns = 0;
+    
+    while (g_running) {
+        switch (reader.read(data)) {
+            case SharedMemoryReader::ReadResult::OK:
+                received++;
+                if (!quiet) {
+                    std::cout << data.symbol << "," << data.price << "," << data.size 
+                              << "," << data.timestamp << std::endl;
+                }
+                break;
+            case SharedMemoryReader::ReadResult::OVERRUN:
+                overruns++;
+                break;
+            case SharedMemoryReader::ReadResult::EMPTY:
+                // Busy-poll briefly, then yield
+                std::this_thread::yield();
+                break;
+        }
+    }
+    
+    std::cout << "\nReceived: " << received 
+              << " Overruns: " << overruns 
+              << " Dropped: " << reader.getDropped() << std::endl;
+    return 0;
+}